@@ -0,0 +1,99 @@
+/********************************************************************************************
+* Supersingular Isogeny Key Encapsulation Library
+*
+* Abstract: modular arithmetic optimized for x64 platforms for P503
+*           The MULX/ADX kernels are selected at runtime, the portable code is the fallback
+*********************************************************************************************/
+
+#include "../P503_internal.h"
+#include <cpuid.h>
+
+// Portable implementation, used for multiplication and reduction on processors without BMI2 and ADX
+#define fpadd503                fpadd503_generic
+#define fpsub503                fpsub503_generic
+#define mp_mul                  mp_mul_generic
+#define mp_sqr                  mp_sqr_generic
+#define rdc_mont                rdc_mont_generic
+#include "../generic/fp_generic.c"
+#undef fpadd503
+#undef fpsub503
+#undef mp_mul
+#undef mp_sqr
+#undef rdc_mont
+
+static int mulx_adx_support = -1;
+
+
+static int has_mulx_adx(void)
+{ // Returns 1 if the processor supports MULX (BMI2) and ADCX/ADOX (ADX), 0 otherwise.
+  // cpuid is queried on the first call only.
+#if defined(_NO_MULX_)
+    return 0;
+#else
+    unsigned int eax, ebx, ecx, edx;
+    int support = 0;
+
+    if (mulx_adx_support < 0) {
+        if (__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) {
+            support = (int)((ebx >> 8) & (ebx >> 19) & 1);    // EBX bit 8: BMI2, EBX bit 19: ADX
+        }
+        mulx_adx_support = support;
+    }
+    return mulx_adx_support;
+#endif
+}
+
+
+__inline void fpadd503(const digit_t* a, const digit_t* b, digit_t* c)
+{ // Modular addition, c = a+b mod p503.
+  // Inputs: a, b in [0, 2*p503-1] 
+  // Output: c in [0, 2*p503-1]
+
+    fpadd503_asm(a, b, c);
+} 
+
+
+__inline void fpsub503(const digit_t* a, const digit_t* b, digit_t* c)
+{ // Modular subtraction, c = a-b mod p503.
+  // Inputs: a, b in [0, 2*p503-1] 
+  // Output: c in [0, 2*p503-1] 
+
+    fpsub503_asm(a, b, c);
+}
+
+
+void mp_mul(const digit_t* a, const digit_t* b, digit_t* c, const unsigned int nwords)
+{ // Multiprecision multiply, c = a*b, where lng(a) = lng(b) = nwords.
+
+    if (has_mulx_adx()) {
+        mul503_asm(a, b, c);
+    } else {
+        mp_mul_generic(a, b, c, nwords);
+    }
+}
+
+
+void mp_sqr(const digit_t* a, digit_t* c, const unsigned int nwords)
+{ // Multiprecision squaring, c = a^2, where lng(a) = nwords.
+  // With MULX/ADX the multiplication kernel is used, a comba squaring gains little over dual carry chains.
+
+    if (has_mulx_adx()) {
+        mul503_asm(a, a, c);
+    } else {
+        mp_sqr_generic(a, c, nwords);
+    }
+}
+
+
+void rdc_mont(const digit_t* ma, digit_t* mc)
+{ // Montgomery reduction exploiting the special form of the prime p503.
+  // mc = ma*R^-1 mod p503x2, where R = 2^512.
+  // If ma < 2^512*p503, the output mc is in the range [0, 2*p503-1].
+  // ma is assumed to be in Montgomery representation.
+
+    if (has_mulx_adx()) {
+        rdc503_asm(ma, mc);
+    } else {
+        rdc_mont_generic(ma, mc);
+    }
+}
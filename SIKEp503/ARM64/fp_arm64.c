@@ -79,6 +79,12 @@ void mp_mul(const digit_t* a, const digit_t* b, digit_t* c, const unsigned int n
     mul503_asm(a, b, c);
 }
 
+void mp_sqr(const digit_t* a, digit_t* c, const unsigned int nwords)
+{ // Multiprecision comba squaring, c = a^2, where lng(a) = nwords.
+    UNREFERENCED_PARAMETER(nwords);
+    sqr503_asm(a, c);
+}
+
 
 void rdc_mont(const dfelm_t ma, felm_t mc)
 { // Efficient Montgomery reduction using comba and exploiting the special form of the prime p503.
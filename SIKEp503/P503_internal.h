@@ -56,6 +56,12 @@ typedef f2elm_t publickey_t[3];                                       // Datatyp
 typedef struct { f2elm_t X; f2elm_t Z; } point_proj;                  // Point representation in projective XZ Montgomery coordinates.
 typedef point_proj point_proj_t[1]; 
 
+typedef struct { f2elm_t x; f2elm_t y; } point_affine;                // Point representation in affine coordinates.
+typedef point_affine point_t[1]; 
+
+typedef struct { f2elm_t X; f2elm_t Y; f2elm_t Z; } point_full_proj;  // Point representation in full projective coordinates.
+typedef point_full_proj point_full_proj_t[1]; 
+
 
 
 /**************** Function prototypes ****************/
@@ -95,6 +101,9 @@ void digit_x_digit(const digit_t a, const digit_t b, digit_t* c);
 // Multiprecision comba multiply, c = a*b, where lng(a) = lng(b) = nwords.
 void mp_mul(const digit_t* a, const digit_t* b, digit_t* c, const unsigned int nwords);
 
+// Multiprecision comba squaring, c = a^2, where lng(a) = nwords.
+void mp_sqr(const digit_t* a, digit_t* c, const unsigned int nwords);
+
 void multiply(const digit_t* a, const digit_t* b, digit_t* c, const unsigned int nwords); 
 
 // Montgomery multiplication modulo the group order, mc = ma*mb*r' mod order, where ma,mb,mc in [0, order-1]
@@ -144,10 +153,12 @@ void fpcorrection503(digit_t* a);
 
 // 503-bit Montgomery reduction, c = a mod p
 void rdc_mont(const digit_t* a, digit_t* c);
+
             
 // Field multiplication using Montgomery arithmetic, c = a*b*R^-1 mod p503, where R=2^768
 void fpmul503_mont(const felm_t a, const felm_t b, felm_t c);
 void mul503_asm(const felm_t a, const felm_t b, dfelm_t c);
+void sqr503_asm(const felm_t a, dfelm_t c);
 void rdc503_asm(const dfelm_t ma, dfelm_t mc);
    
 // Field squaring using Montgomery arithmetic, c = a*b*R^-1 mod p503, where R=2^768
@@ -165,9 +176,21 @@ void fpinv503_mont(felm_t a);
 // Field inversion, a = a^-1 in GF(p503) using the binary GCD 
 void fpinv503_mont_bingcd(felm_t a);
 
+// Constant-time field inversion, a = a^-1 in GF(p503) using the safegcd divsteps
+void fpinv503_mont_safegcd(felm_t a);
+
 // Chain to compute (p503-3)/4 using Montgomery arithmetic
 void fpinv503_chain_mont(felm_t a);
 
+// Exponentiation c = a^e in GF(p503) for an exponent e of nbits bits, with fixed windows in constant time
+void fpexp503_mont(const felm_t a, const digit_t* e, const unsigned int nbits, felm_t c);
+
+// Square root c = a^((p503+1)/4) in GF(p503), c^2 = a if a is a square, c^2 = -a otherwise
+void fpsqrt503_mont(const felm_t a, felm_t c);
+
+// Legendre symbol of a in GF(p503), returns 1, -1 or 0 (for a = 0)
+int fp_legendre503(const felm_t a);
+
 /************ GF(p^2) arithmetic functions *************/
     
 // Copy of a GF(p503^2) element, c = a
@@ -209,14 +232,29 @@ void fp2inv503_mont(f2elm_t a);
 // GF(p503^2) inversion, a = (a0-i*a1)/(a0^2+a1^2), GF(p503) inversion done using the binary GCD 
 void fp2inv503_mont_bingcd(f2elm_t a);
 
-// n-way Montgomery inversion
+// n-way Montgomery inversion, out[i] = 1/vec[i]. out is used as scratch space and must not overlap vec
 void mont_n_way_inv(const f2elm_t* vec, const int n, f2elm_t* out);
 
+// n-way Montgomery inversion using the binary GCD on the product of all vec[i] multiplied by mask
+void mont_n_way_inv_bingcd(const f2elm_t* vec, const int n, f2elm_t* out, const f2elm_t mask);
+
+// Exponentiation c = a^e in GF(p503^2) for an exponent e of nbits bits, with fixed windows in constant time
+void fp2exp503_mont(const f2elm_t a, const digit_t* e, const unsigned int nbits, f2elm_t c);
+
+// Is a a square in GF(p503^2)? Returns 1 (TRUE) or 0 (FALSE)
+unsigned int fp2_is_square503(const f2elm_t a);
+
+// Square root c of a square a in GF(p503^2), c^2 = a
+void fp2sqrt503(const f2elm_t a, f2elm_t c);
+
 /************ Elliptic curve and isogeny functions *************/
 
 // Computes the j-invariant of a Montgomery curve with projective constant.
 void j_inv(const f2elm_t A, const f2elm_t C, f2elm_t jinv);
 
+// Computes the j-invariant of a Montgomery curve with projective constant as a fraction jnum/jden, without inversion.
+void j_inv_proj(const f2elm_t A, const f2elm_t C, f2elm_t jnum, f2elm_t jden);
+
 // Simultaneous doubling and differential addition.
 void xDBLADD(point_proj_t P, point_proj_t Q, const f2elm_t xPQ, const f2elm_t A24);
 
@@ -250,8 +288,14 @@ void eval_3_isog(point_proj_t Q, const f2elm_t* coeff);
 // 3-way simultaneous inversion
 void inv_3_way(f2elm_t z1, f2elm_t z2, f2elm_t z3);
 
+// 3-way simultaneous inversion of secret values, using the variable-time inversion on the product masked by mask
+void inv_3_way_bingcd(f2elm_t z1, f2elm_t z2, f2elm_t z3, const f2elm_t mask);
+
 // Given the x-coordinates of P, Q, and R, returns the value A corresponding to the Montgomery curve E_A: y^2=x^3+A*x^2+x such that R=Q-P on E_A.
 void get_A(const f2elm_t xP, const f2elm_t xQ, const f2elm_t xR, f2elm_t A);
 
+// Projective version of get_A, returns (A:C) such that A/C = A from get_A, without inversion.
+void get_A_proj(const f2elm_t xP, const f2elm_t xQ, const f2elm_t xR, f2elm_t A, f2elm_t C);
+
 
 #endif
@@ -40,12 +40,24 @@
 // Definition of the targeted architecture and basic data types
     
 #define TARGET_ARM64        1
+#define TARGET_GENERIC      2
+#define TARGET_AMD64        3
 
 #if defined(_ARM64_)
     #define TARGET TARGET_ARM64
     #define RADIX           64
     #define LOG2RADIX       6
     typedef uint64_t        digit_t;        // Unsigned 64-bit digit
+#elif defined(_GENERIC_)
+    #define TARGET TARGET_GENERIC
+    #define RADIX           64
+    #define LOG2RADIX       6
+    typedef uint64_t        digit_t;        // Unsigned 64-bit digit
+#elif defined(_AMD64_)
+    #define TARGET TARGET_AMD64
+    #define RADIX           64
+    #define LOG2RADIX       6
+    typedef uint64_t        digit_t;        // Unsigned 64-bit digit
 #else
     #error -- "Unsupported ARCHITECTURE"
 #endif
@@ -59,11 +71,18 @@
     #define OPTIMIZED_FAST_IMPLEMENTATION
 #endif
 
+// Selection of implementation: portable C, no assembly
+
+#if defined(_GENERIC_)
+    #define GENERIC_IMPLEMENTATION
+#endif
+
 
 // Extended datatype support
  
 #define UINT128_SUPPORT
 typedef unsigned uint128_t __attribute__((mode(TI)));
+typedef int int128_t __attribute__((mode(TI)));
     
 
 // Macro definitions
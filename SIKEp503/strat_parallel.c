@@ -0,0 +1,61 @@
+/********************************************************************************************
+* Supersingular Isogeny Key Encapsulation Library
+*
+* Abstract: strategies for the isogeny tree traversal in p503 = 2^250*3^159-1
+*           Generated by tools/gen_strategy.c, do not edit.
+*
+* Costs in multiplications in GF(p): xDBL 16, xTPL 22, get_4_isog 8, eval_4_isog 16,
+* get_3_isog 12, eval_3_isog 10. Simulated key generation plus shared secret:
+* 2 cores: Alice 36312 (sequential strategy 36840), Bob 32712 (33230)
+* 3 cores: Alice 32920 (sequential strategy 33888), Bob 29758 (30616)
+* 4 cores: Alice 31680 (sequential strategy 32704), Bob 28168 (29446)
+*********************************************************************************************/
+
+#if (_ISOG_THREADS_ == 2)
+const unsigned int strat_Alice[MAX_Alice-1] = { 
+40, 31, 20, 14, 10, 6, 3, 2, 1, 3, 2, 1, 1, 1, 4, 3, 2, 1, 1, 1, 1, 1, 1, 4, 4, 
+3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 6, 4, 4, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 2, 1, 
+1, 1, 1, 9, 7, 5, 4, 3, 2, 1, 1, 1, 1, 1, 1, 2, 1, 1, 1, 2, 2, 1, 1, 1, 1, 3, 2, 
+1, 1, 1, 1, 1, 1, 13, 8, 6, 4, 3, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 2, 1, 1, 1, 1, 2, 
+2, 1, 1, 1, 1, 1, 3, 3, 2, 2, 1, 1, 1, 1, 1, 1, 1, 1 };
+
+const unsigned int strat_Bob[MAX_Bob-1] = { 
+49, 33, 25, 18, 14, 10, 6, 3, 2, 1, 3, 2, 1, 1, 1, 4, 3, 2, 1, 1, 1, 1, 1, 1, 4, 
+4, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 5, 4, 3, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 2, 1, 
+1, 1, 7, 5, 4, 3, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 2, 1, 1, 1, 2, 2, 1, 1, 1, 1, 8, 
+7, 5, 4, 3, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 2, 1, 1, 1, 2, 2, 1, 1, 1, 1, 2, 2, 1, 
+1, 1, 1, 1, 13, 10, 7, 5, 4, 4, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 2, 1, 1, 1, 2, 
+2, 1, 1, 1, 1, 3, 2, 2, 1, 1, 1, 1, 1, 1, 3, 3, 2, 2, 1, 1, 1, 1, 1, 1, 1, 1 };
+#elif (_ISOG_THREADS_ == 3)
+const unsigned int strat_Alice[MAX_Alice-1] = { 
+40, 29, 21, 15, 10, 6, 3, 2, 1, 3, 2, 1, 1, 1, 4, 3, 2, 1, 1, 1, 1, 1, 1, 5, 4, 
+3, 2, 1, 1, 1, 1, 1, 1, 2, 1, 1, 1, 7, 5, 3, 3, 2, 1, 1, 1, 1, 1, 2, 1, 1, 1, 2, 
+2, 1, 1, 1, 1, 8, 7, 5, 3, 3, 2, 1, 1, 1, 1, 1, 2, 1, 1, 1, 2, 2, 1, 1, 1, 1, 2, 
+1, 2, 1, 1, 1, 1, 11, 8, 7, 5, 3, 3, 2, 1, 1, 1, 1, 1, 2, 1, 1, 1, 2, 2, 1, 1, 1, 
+1, 2, 1, 2, 1, 1, 1, 1, 2, 2, 2, 2, 1, 1, 1, 1, 1, 1 };
+
+const unsigned int strat_Bob[MAX_Bob-1] = { 
+43, 33, 27, 21, 15, 10, 6, 3, 2, 1, 3, 2, 1, 1, 1, 4, 3, 2, 1, 1, 1, 1, 1, 1, 5, 
+4, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 6, 5, 4, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 
+1, 2, 1, 1, 1, 1, 7, 5, 5, 4, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 2, 1, 1, 1, 2, 
+2, 1, 1, 1, 1, 8, 7, 5, 4, 3, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 2, 1, 1, 1, 2, 2, 1, 
+1, 1, 1, 2, 1, 2, 1, 1, 1, 1, 11, 8, 6, 5, 4, 3, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 2, 
+1, 1, 1, 1, 2, 1, 1, 1, 2, 1, 2, 1, 1, 1, 1, 2, 2, 2, 2, 1, 1, 1, 1, 1, 1 };
+#elif (_ISOG_THREADS_ == 4)
+const unsigned int strat_Alice[MAX_Alice-1] = { 
+40, 29, 21, 15, 10, 6, 3, 2, 1, 3, 2, 1, 1, 1, 4, 3, 2, 1, 1, 1, 1, 1, 1, 5, 4, 
+3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 6, 5, 4, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 
+1, 1, 1, 1, 1, 8, 6, 5, 4, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 2, 
+1, 1, 1, 1, 1, 1, 11, 8, 6, 5, 4, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 
+1, 2, 1, 1, 1, 1, 1, 1, 2, 2, 2, 1, 1, 1, 1, 1, 1, 1 };
+
+const unsigned int strat_Bob[MAX_Bob-1] = { 
+39, 36, 28, 21, 15, 10, 6, 3, 2, 1, 3, 2, 1, 1, 1, 4, 3, 2, 1, 1, 1, 1, 1, 1, 5, 
+4, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 6, 5, 4, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 
+1, 1, 1, 1, 1, 1, 7, 6, 5, 4, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 
+1, 1, 1, 1, 1, 1, 8, 7, 6, 5, 4, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 
+1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 9, 7, 6, 5, 4, 3, 2, 2, 1, 1, 1, 1, 1, 
+1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1 };
+#else
+    #error -- "No strategy for _ISOG_THREADS_ cores"
+#endif
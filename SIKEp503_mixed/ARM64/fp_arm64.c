@@ -7,7 +7,14 @@
 *********************************************************************************************/
 
 
+#define _GNU_SOURCE
 #include "../P503_internal.h"
+#include <limits.h>
+#include <sched.h>
+#include <stdio.h>
+#include <time.h>
+#include <sys/auxv.h>
+#include <sys/prctl.h>
 
 extern const digit_t p503[NWORDS_FIELD];
 extern const digit_t p503p1[NWORDS_FIELD];
@@ -896,10 +903,320 @@ void fpcorrection503(digit_t* a)
     }
 }
 
+/********************************************************************************************
+* Runtime choice between the GPR-only kernels of SIKEp503 and the mixed GPR/ASIMD kernels.
+* The mixed kernels rely on out-of-order issue to overlap the integer and the ASIMD streams,
+* so the in-order cores below default to the GPR-only ones. The choice is made per core type,
+* i.e., per MIDR: every thread looks up the choice for the core it runs on, and looks again
+* every KERNELS_RECHECK field operations in case it migrated, so the big and the LITTLE cores
+* of a system each run their own kernels. KERNELS=CALIBRATE instead times both kernels of
+* every operation once per core type, on the first core of that type, and keeps the faster one.
+* On processors with SVE2, the SVE2 kernels are one more candidate for the multiplications and
+* the reduction: by default they are chosen when the vectors are wider than 128 bits, and
+* KERNELS=CALIBRATE times them like the other kernels. KERNELS=MIXED and KERNELS=GPR keep their
+* kernels. The GF(p^2) kernels are chosen independently of SVE2.
+*********************************************************************************************/
+
+#ifndef HWCAP_CPUID
+    #define HWCAP_CPUID    (1 << 11)
+#endif
+#ifndef AT_HWCAP2
+    #define AT_HWCAP2      26
+#endif
+#ifndef HWCAP2_SVE2
+    #define HWCAP2_SVE2    (1 << 1)
+#endif
+#ifndef PR_SVE_GET_VL
+    #define PR_SVE_GET_VL         51
+    #define PR_SVE_VL_LEN_MASK    0xffff
+#endif
+
+#define CALIBRATION_LOOPS     256
+#define CALIBRATION_ROUNDS    8
+#define KERNELS_RECHECK       1024    // Field operations between two checks of the core of a thread
+#define KERNELS_MAX_CPUS      1024
+#define KERNELS_MAX_TYPES     16
+
+// Choice per core type: MIDR in the upper 32 bits, KERNELS_VALID and the choice in the lower ones, 0 for a free entry.
+// Entries are claimed with compare-and-swap and never change afterwards.
+#define KERNELS_VALID         0x80000000
+static uint64_t core_kernels[KERNELS_MAX_TYPES];
+static unsigned int cpu_kernels[KERNELS_MAX_CPUS];     // Choice per CPU plus 1, 0 if not known yet
+static int kernels_fixed = -1;                         // Set by fp_kernels_set()
+
+static __thread unsigned int thread_kernels;           // Choice for the core of the thread
+static __thread unsigned int thread_calls = 0;         // Field operations left before the next check
+
+static const unsigned int inorder_parts[] = {    // Arm Ltd. in-order cores
+    0xD03,    // Cortex-A53
+    0xD04,    // Cortex-A35
+    0xD05,    // Cortex-A55
+    0xD46,    // Cortex-A510
+    0xD80,    // Cortex-A520
+};
+
+
+static uint64_t read_midr(const int cpu)
+{ // MIDR_EL1 of the given CPU, or of the current one if cpu < 0. 0 if it cannot be read.
+  // Read from sysfs if available, otherwise from MIDR_EL1 through the kernel emulation, then from /proc/cpuinfo.
+    uint64_t midr = 0;
+    unsigned int implementer = 0, part = 0, v;
+    int current = -1;
+    unsigned long long m;
+    char line[256];
+    FILE* f;
+
+    if (cpu >= 0) {
+        snprintf(line, sizeof(line), "/sys/devices/system/cpu/cpu%d/regs/identification/midr_el1", cpu);
+        f = fopen(line, "r");
+        if (f != NULL) {
+            if (fscanf(f, "%llx", &m) != 1) m = 0;
+            fclose(f);
+            if (m != 0) return (uint64_t)m;
+        }
+    }
+
+    if (getauxval(AT_HWCAP) & HWCAP_CPUID) {
+        __asm__ __volatile__ ("mrs %0, MIDR_EL1" : "=r" (midr));
+        return midr;
+    }
+
+    f = fopen("/proc/cpuinfo", "r");
+    if (f == NULL) return 0;
+    while (fgets(line, sizeof(line), f) != NULL) {
+        if (sscanf(line, "processor : %u", &v) == 1) {
+            if (current >= 0 && (cpu < 0 || current == cpu)) break;
+            current = (int)v;
+        } else if (cpu >= 0 && current != cpu) {
+            continue;
+        } else if (sscanf(line, "CPU implementer : %x", &v) == 1) {
+            implementer = v;
+        } else if (sscanf(line, "CPU part : %x", &v) == 1) {
+            part = v;
+        }
+    }
+    fclose(f);
+    return ((uint64_t)implementer << 24) | ((uint64_t)part << 4);
+}
+
+
+static int sve2_support(void)
+{ // SVE2 reported by the kernel, unless built with USE_SVE2=FALSE
+#if defined(_NO_SVE2_)
+    return 0;
+#else
+    return (getauxval(AT_HWCAP2) & HWCAP2_SVE2) != 0;
+#endif
+}
+
+
+static unsigned int sve_vector_bits(void)
+{ // SVE vector length of the calling thread in bits, 0 if it cannot be read
+    int vl = prctl(PR_SVE_GET_VL);
+
+    return (vl < 0) ? 0 : (unsigned int)(vl & PR_SVE_VL_LEN_MASK)*8;
+}
+
+
+static unsigned int kernels_from_midr(uint64_t midr)
+{ // Mixed kernels for every operation, except on the in-order cores
+    unsigned int i, implementer = (unsigned int)(midr >> 24) & 0xFF, part = (unsigned int)(midr >> 4) & 0xFFF;
+
+    if (implementer == 0x41) {
+        for (i = 0; i < sizeof(inorder_parts)/sizeof(inorder_parts[0]); i++) {
+            if (part == inorder_parts[i]) return 0;
+        }
+    }
+    return FP_KERNEL_ALL;
+}
+
+
+static uint64_t kernel_time(unsigned int op)
+{ // Best time in nanoseconds of CALIBRATION_LOOPS calls of op with the current kernels
+    unsigned int i, j;
+    felm_t a, b, r;
+    dfelm_t c, d;
+    f2elm_t e, g;
+    struct timespec t0, t1;
+    uint64_t t, best = (uint64_t)-1;
+
+    for (i = 0; i < NWORDS_FIELD; i++) {            // Any value below p503, the kernels run in constant time
+        a[i] = ((digit_t*)p503)[i] ^ (digit_t)(0x5555555555555555ULL*(i+1));
+        b[i] = ((digit_t*)p503)[i] ^ (digit_t)(0x3333333333333333ULL*(i+1));
+    }
+    a[NWORDS_FIELD-1] = ((digit_t*)p503)[NWORDS_FIELD-1] >> 1;
+    b[NWORDS_FIELD-1] = ((digit_t*)p503)[NWORDS_FIELD-1] >> 2;
+    fpcopy503(a, e[0]); fpcopy503(b, e[1]);
+
+    for (j = 0; j < CALIBRATION_ROUNDS; j++) {
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        for (i = 0; i < CALIBRATION_LOOPS; i++) {
+            switch (op) {
+            case FP_KERNEL_MUL:    mp_mul(a, b, c, NWORDS_FIELD); break;
+            case FP_KERNEL_MUL_X2: mp_mul_x2(a, b, c, b, a, d, NWORDS_FIELD); break;
+            case FP_KERNEL_FP2MUL: fp2mul503_mont(e, e, g); break;
+            case FP_KERNEL_FP2SQR: fp2sqr503_mont(e, g); break;
+            case FP_KERNEL_SVE2:   fpmul503_mont(a, b, r); mp_mul_x2(a, b, c, b, a, d, NWORDS_FIELD); break;
+            }
+        }
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        t = (uint64_t)(t1.tv_sec - t0.tv_sec)*1000000000 + (uint64_t)t1.tv_nsec - (uint64_t)t0.tv_nsec;
+        if (t < best) best = t;
+    }
+    return best;
+}
+
+
+static unsigned int kernels_calibrate(void)
+{ // Times the GPR-only and the mixed kernel of every operation. The GF(p^2) operations come last,
+  // so that their GPR-only path runs with the kernel already chosen for mp_mul.
+    static const unsigned int ops[] = { FP_KERNEL_MUL, FP_KERNEL_MUL_X2, FP_KERNEL_FP2MUL, FP_KERNEL_FP2SQR };
+    unsigned int i, chosen = 0;
+    uint64_t t_gpr, t_mixed;
+    int sve2 = sve2_support();
+
+    thread_calls = UINT_MAX;                   // The candidates below only apply to the calling thread
+    for (i = 0; i < sizeof(ops)/sizeof(ops[0]); i++) {
+        if (ops[i] == FP_KERNEL_FP2MUL && sve2) {    // Montgomery multiplication and two products, with and without SVE2
+            thread_kernels = chosen;
+            t_gpr = kernel_time(FP_KERNEL_SVE2);
+            thread_kernels = chosen | FP_KERNEL_SVE2;
+            t_mixed = kernel_time(FP_KERNEL_SVE2);
+            if (t_mixed < t_gpr) chosen |= FP_KERNEL_SVE2;
+        }
+        thread_kernels = chosen;
+        t_gpr = kernel_time(ops[i]);
+        thread_kernels = chosen | ops[i];
+        t_mixed = kernel_time(ops[i]);
+        if (t_mixed <= t_gpr) chosen |= ops[i];
+    }
+    return chosen;
+}
+
+
+static unsigned int kernels_choose(uint64_t midr)
+{ // Choice for a core type
+#if defined(_KERNELS_CALIBRATE_)
+    (void)midr;
+    return kernels_calibrate();
+#elif defined(_KERNELS_MIXED_)
+    (void)midr;
+    return FP_KERNEL_ALL;
+#elif defined(_KERNELS_GPR_)
+    (void)midr;
+    return 0;
+#else
+    unsigned int k = kernels_from_midr(midr);
+
+    if (sve2_support() && sve_vector_bits() > 128) {    // Cores with 128-bit SVE2 (e.g., Neoverse N2/V2, Cortex-A710/X2) keep ASIMD
+        k = FP_KERNEL_SVE2 | (k & (FP_KERNEL_FP2MUL | FP_KERNEL_FP2SQR));
+    }
+    return k;
+#endif
+}
+
+
+static unsigned int kernels_for_midr(uint64_t midr)
+{ // Choice for the core type of the given MIDR, made on the first call for that type and published once made
+    uint64_t entry, key = (midr & 0xFFFFFFFF) << 32;
+    unsigned int i, chosen;
+
+    for (i = 0; i < KERNELS_MAX_TYPES; i++) {
+        entry = __atomic_load_n(&core_kernels[i], __ATOMIC_ACQUIRE);
+        if (entry == 0) break;
+        if ((entry & 0xFFFFFFFF00000000ULL) == key) return (unsigned int)entry & ~KERNELS_VALID;
+    }
+    chosen = kernels_choose(midr);
+    for (i = 0; i < KERNELS_MAX_TYPES; i++) {    // Another thread may have chosen for the same type meanwhile, its choice wins
+        entry = 0;
+        if (__atomic_compare_exchange_n(&core_kernels[i], &entry, key | KERNELS_VALID | chosen, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) break;
+        if ((entry & 0xFFFFFFFF00000000ULL) == key) return (unsigned int)entry & ~KERNELS_VALID;
+    }
+    return chosen;
+}
+
+
+static unsigned int kernels_update(void)
+{ // Choice for the core that runs the calling thread, checked again after KERNELS_RECHECK field operations
+    int fixed = __atomic_load_n(&kernels_fixed, __ATOMIC_ACQUIRE);
+    int cpu = sched_getcpu();
+    unsigned int k;
+
+    if (fixed >= 0) {
+        k = (unsigned int)fixed;
+    } else if (cpu < 0 || cpu >= KERNELS_MAX_CPUS) {
+        k = kernels_for_midr(read_midr(-1));
+    } else {
+        k = __atomic_load_n(&cpu_kernels[cpu], __ATOMIC_ACQUIRE);
+        if (k == 0) {
+            k = kernels_for_midr(read_midr(cpu)) + 1;
+            __atomic_store_n(&cpu_kernels[cpu], k, __ATOMIC_RELEASE);
+        }
+        k -= 1;
+    }
+    thread_kernels = k;
+    thread_calls = KERNELS_RECHECK;
+    return k;
+}
+
+
+static __inline unsigned int kernels(void)
+{
+    if (thread_calls == 0) return kernels_update();
+    thread_calls--;
+    return thread_kernels;
+}
+
+
+unsigned int fp_kernels_mixed(void)
+{ // Set of the operations that run the mixed kernel on the core of the calling thread
+    return kernels();
+}
+
+
+void fp_kernels_set(unsigned int mixed)
+{ // Replaces the choice of fp_kernels_mixed() on all the cores. Other threads see it after at most KERNELS_RECHECK field operations
+    __atomic_store_n(&kernels_fixed, (int)(mixed & (sve2_support() ? (FP_KERNEL_ALL | FP_KERNEL_SVE2) : FP_KERNEL_ALL)), __ATOMIC_RELEASE);
+    thread_calls = 0;
+}
+
+
 void mp_mul(const digit_t* a, const digit_t* b, digit_t* c, const unsigned int nwords)
 { // Multiprecision comba multiply, c = a*b, where lng(a) = lng(b) = nwords.
+    unsigned int k = kernels();
+
+    UNREFERENCED_PARAMETER(nwords);
+    if (k & FP_KERNEL_SVE2) {
+        mul503_sve2_asm(a, b, c);
+    } else if (k & FP_KERNEL_MUL) {
+        fpmul512_karatsuba(a, b, c);
+    } else {
+        mul503_gpr_asm(a, b, c);
+    }
+}
+
+void mp_mul_x2(const digit_t* a0, const digit_t* b0, digit_t* c0, const digit_t* a1, const digit_t* b1, digit_t* c1, const unsigned int nwords)
+{ // Two independent multiprecision multiplications, c0 = a0*b0 and c1 = a1*b1, where all operands have nwords.
+  // The mixed kernel runs a0*b0 on ASIMD and a1*b1 on the general registers, interleaved.
+  // c0 and c1 must not overlap any of the inputs.
+    unsigned int k = kernels();
+
     UNREFERENCED_PARAMETER(nwords);
-    fpmul512_karatsuba(a, b, c);
+    if (k & FP_KERNEL_SVE2) {
+        mul503_sve2_asm(a0, b0, c0);
+        mul503_sve2_asm(a1, b1, c1);
+    } else if (k & FP_KERNEL_MUL_X2) {
+        mul503_x2_asm(a0, b0, c0, a1, b1, c1);
+    } else {
+        mul503_gpr_asm(a0, b0, c0);
+        mul503_gpr_asm(a1, b1, c1);
+    }
+}
+
+void mp_sqr(const digit_t* a, digit_t* c, const unsigned int nwords)
+{ // Multiprecision squaring, c = a^2, where lng(a) = nwords.
+  // There is no mixed ASIMD/GPR squaring kernel for this prime, the multiplication kernels square.
+    mp_mul(a, a, c, nwords);
 }
 
 
@@ -908,5 +1225,9 @@ void rdc_mont(const dfelm_t ma, felm_t mc)
     // mc = ma*R^-1 mod p503x2, where R = 2^512.
     // If ma < 2^512*p503, the output mc is in the range [0, 2*p503-1].
     // ma is assumed to be in Montgomery representation.
-    rdc503_asm(ma, mc);
+    if (kernels() & FP_KERNEL_SVE2) {
+        rdc503_sve2_asm(ma, mc);
+    } else {
+        rdc503_asm(ma, mc);
+    }
 }
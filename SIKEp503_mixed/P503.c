@@ -66,6 +66,11 @@ const uint64_t Border_div3[NWORDS_ORDER]         = { 0xEB5CFCD82C28A2B9, 0x4CFF3
 
 
 // Fixed parameters for isogeny tree computation
+#if defined(_STRAT_TUNED_)
+#include "strat_tuned.h"                        // Strategies for the costs measured by "make tune"
+#elif defined(_ISOG_THREADS_)
+#include "strat_parallel.c"                     // Strategies for the traversal on _ISOG_THREADS_ cores
+#else
 const unsigned int strat_Alice[MAX_Alice-1] = { 
 61, 32, 16, 8, 4, 2, 1, 1, 2, 1, 1, 4, 2, 1, 1, 2, 1, 1, 8, 4, 2, 1, 1, 2, 1, 1, 
 4, 2, 1, 1, 2, 1, 1, 16, 8, 4, 2, 1, 1, 2, 1, 1, 4, 2, 1, 1, 2, 1, 1, 8, 4, 2, 1, 
@@ -80,6 +85,7 @@ const unsigned int strat_Bob[MAX_Bob-1] = {
 1, 4, 2, 1, 1, 2, 1, 1, 33, 17, 9, 5, 3, 2, 1, 1, 1, 1, 2, 1, 1, 1, 4, 2, 1, 1, 1, 
 2, 1, 1, 8, 4, 2, 1, 1, 1, 2, 1, 1, 4, 2, 1, 1, 2, 1, 1, 16, 8, 4, 2, 1, 1, 1, 2, 
 1, 1, 4, 2, 1, 1, 2, 1, 1, 8, 4, 2, 1, 1, 2, 1, 1, 4, 2, 1, 1, 2, 1, 1 };
+#endif
            
 // Setting up macro defines and including GF(p), GF(p^2), curve, isogeny and kex functions
 #define fpcopy                  fpcopy503
@@ -90,10 +96,15 @@ const unsigned int strat_Bob[MAX_Bob-1] = {
 #define fpdiv2                  fpdiv2_503
 #define fpcorrection            fpcorrection503
 #define fpmul_mont              fpmul503_mont
+#define fpmul_mont_x2           fpmul503_mont_x2
 #define fpsqr_mont              fpsqr503_mont
 #define fpinv_mont              fpinv503_mont
 #define fpinv_chain_mont        fpinv503_chain_mont
+#define fpexp_mont              fpexp503_mont
+#define fpsqrt_mont             fpsqrt503_mont
+#define fp_legendre             fp_legendre503
 #define fpinv_mont_bingcd       fpinv503_mont_bingcd
+#define fpinv_mont_safegcd      fpinv503_mont_safegcd
 #define fp2copy                 fp2copy503
 #define fp2zero                 fp2zero503
 #define fp2add                  fp2add503
@@ -102,9 +113,15 @@ const unsigned int strat_Bob[MAX_Bob-1] = {
 #define fp2div2                 fp2div2_503
 #define fp2correction           fp2correction503
 #define fp2mul_mont             fp2mul503_mont
+#define fp2mul_mont_asm         fp2mul503_mont_asm
+#define fp2mul_mont_x2          fp2mul503_mont_x2
 #define fp2sqr_mont             fp2sqr503_mont
+#define fp2sqr_mont_asm         fp2sqr503_mont_asm
 #define fp2inv_mont             fp2inv503_mont
 #define fp2inv_mont_bingcd      fp2inv503_mont_bingcd
+#define fp2exp_mont             fp2exp503_mont
+#define fp2_is_square           fp2_is_square503
+#define fp2sqrt                 fp2sqrt503
 #define fpequal_non_constant_time  fpequal503_non_constant_time
 #define mp_add_asm              mp_add503_asm
 #define mp_addx2_asm            mp_add503x2_asm
@@ -113,4 +130,7 @@ const unsigned int strat_Bob[MAX_Bob-1] = {
 #include "fpx.c"
 #include "ec_isogeny.c"
 #include "sidh.c"    
-#include "sike.c"
\ No newline at end of file
+#include "sidh_compressed.c"
+#include "sike.c"
+#include "sike_compressed.c"
+#include "sike_step.c"
\ No newline at end of file
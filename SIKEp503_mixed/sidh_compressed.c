@@ -0,0 +1,814 @@
+/********************************************************************************************
+* Supersingular Isogeny Key Encapsulation Library
+*
+* Abstract: compression of SIDH public keys
+*
+* A public key x(P), x(Q), x(P-Q) on E_A is replaced by A and the coordinates of P and Q in a
+* basis {R1, R2} of the same torsion subgroup, which both sides generate deterministically from
+* A. The coordinates are discrete logarithms of Weil pairings in the subgroup of order 2^eA or
+* 3^eB of GF(p^2)*. Bob's public keys keep their coordinates scaled so that one of them is 1,
+* which leaves 3 scalars and one bit. Decompression returns x(cP), x(cQ), x(cP-cQ) for the scalar
+* c, which give the same kernel <cP + m*cQ> = <P + m*Q> in the shared secret computation.
+* Alice's public keys, the ciphertexts of the KEM, keep the 4 coordinates of P and Q, with the sign
+* of (P, Q) fixed, so that decompression returns the public key itself. Decapsulation then checks
+* a ciphertext against the decompressed one and never compresses its secret re-encryption.
+*
+* All the functions in this file process public keys only and do not run in constant time.
+*********************************************************************************************/
+
+#include <string.h>
+#include "P503_internal.h"
+
+
+#define DLOG_MAX_DIGITS                 ((OALICE_BITS > OBOB_EXPON) ? OALICE_BITS : OBOB_EXPON)
+#define TORSION_MAX_TRIES               256     // Bound on the candidate points of torsion_basis, reached only on a malformed curve
+
+
+/********************************************************************************************
+* GF(p) and GF(p^2) helpers
+*********************************************************************************************/
+
+static bool fpequal_vartime(const felm_t a, const felm_t b)
+{ // Is a = b in GF(p)? a and b in [0, 2p-1]
+    felm_t t;
+    digit_t r = 0;
+    unsigned int i;
+
+    fpsub(a, b, t);
+    fpcorrection(t);
+    for (i = 0; i < NWORDS_FIELD; i++) r |= t[i];
+    return (r == 0);
+}
+
+
+static bool fp2equal_vartime(const f2elm_t a, const f2elm_t b)
+{ // Is a = b in GF(p^2)?
+    return fpequal_vartime(a[0], b[0]) && fpequal_vartime(a[1], b[1]);
+}
+
+
+static bool fp2is_zero_vartime(const f2elm_t a)
+{ // Is a = 0 in GF(p^2)?
+    f2elm_t zero = {0};
+
+    return fp2equal_vartime(a, zero);
+}
+
+
+static void curve_rhs(const f2elm_t x, const f2elm_t A, f2elm_t c)
+{ // c = x^3+A*x^2+x
+    f2elm_t t;
+
+    fp2add(x, A, t);
+    fp2mul_mont(t, x, t);
+    fpadd(t[0], (digit_t*)&Montgomery_one, t[0]);
+    fp2mul_mont(t, x, c);
+}
+
+
+/********************************************************************************************
+* Scalars modulo the subgroup order 2^eA (ALICE) or 3^eB (BOB)
+*********************************************************************************************/
+
+static void scalar_decode(const unsigned char* enc, digit_t* s, const unsigned int AliceOrBob)
+{ // Little endian bytes to a scalar
+    unsigned int nbytes = (AliceOrBob == ALICE) ? SECRETKEY_A_BYTES : SECRETKEY_B_BYTES;
+
+    memset(s, 0, NWORDS_ORDER*sizeof(digit_t));
+    memcpy(s, enc, nbytes);
+}
+
+
+static void scalar_encode(const digit_t* s, unsigned char* enc, const unsigned int AliceOrBob)
+{ // Scalar to little endian bytes
+    unsigned int nbytes = (AliceOrBob == ALICE) ? SECRETKEY_A_BYTES : SECRETKEY_B_BYTES;
+
+    memcpy(enc, s, nbytes);
+}
+
+
+static void scalar_mask_A(digit_t* s)
+{ // s = s mod 2^eA
+    unsigned int i;
+
+    for (i = OALICE_BITS; i < NWORDS_ORDER*RADIX; i++) {
+        s[i >> LOG2RADIX] &= ~((digit_t)1 << (i & (RADIX-1)));
+    }
+}
+
+
+static bool scalar_is_valid(const digit_t* s, const unsigned int AliceOrBob)
+{ // Is s in [0, order-1]?
+    digit_t t[NWORDS_ORDER];
+
+    if (AliceOrBob == ALICE) {
+        copy_words(s, t, NWORDS_ORDER);
+        scalar_mask_A(t);
+        return (memcmp(s, t, sizeof(t)) == 0);
+    }
+    return is_lt_mod_order(s, (digit_t*)Bob_order);
+}
+
+
+static bool scalar_is_unit(const digit_t* s, const unsigned int AliceOrBob)
+{ // Is s invertible modulo the order? For 3^eB, s mod 3 is the sum of its digits mod 3 as 2^RADIX = 1 mod 3
+    digit_t r = 0;
+    unsigned int i;
+
+    if (AliceOrBob == ALICE) {
+        return (s[0] & 1);
+    }
+    for (i = 0; i < NWORDS_ORDER; i++) {
+        r += s[i] % 3;
+    }
+    return (r % 3 != 0);
+}
+
+
+static void scalar_mul(const digit_t* a, const digit_t* b, digit_t* c, const unsigned int AliceOrBob)
+{ // c = a*b mod order
+    digit_t t[2*NWORDS_ORDER], ma[NWORDS_ORDER], mb[NWORDS_ORDER];
+
+    if (AliceOrBob == ALICE) {
+        mp_mul_order(a, b, t);
+        copy_words(t, c, NWORDS_ORDER);
+        scalar_mask_A(c);
+    } else {
+        to_Montgomery_mod_order(a, ma, (digit_t*)Bob_order, (digit_t*)Montgomery_rprime, (digit_t*)Montgomery_Rprime);
+        to_Montgomery_mod_order(b, mb, (digit_t*)Bob_order, (digit_t*)Montgomery_rprime, (digit_t*)Montgomery_Rprime);
+        Montgomery_multiply_mod_order(ma, mb, ma, (digit_t*)Bob_order, (digit_t*)Montgomery_rprime);
+        from_Montgomery_mod_order(ma, c, (digit_t*)Bob_order, (digit_t*)Montgomery_rprime);
+    }
+}
+
+
+static void scalar_sub(const digit_t* a, const digit_t* b, digit_t* c, const unsigned int AliceOrBob)
+{ // c = a-b mod order
+    if (AliceOrBob == ALICE) {
+        mp_sub(a, b, c, NWORDS_ORDER);
+        scalar_mask_A(c);
+    } else if (mp_sub(a, b, c, NWORDS_ORDER)) {
+        mp_add(c, (digit_t*)Bob_order, c, NWORDS_ORDER);
+    }
+}
+
+
+static int scalar_sign(const digit_t* s, const unsigned int AliceOrBob)
+{ // 1 if s > -s modulo the order, -1 if s < -s and 0 if s = -s, which means s = 0 for the odd order 3^eB
+    digit_t t[NWORDS_ORDER], zero[NWORDS_ORDER] = {0};
+    int i;
+
+    scalar_sub(zero, s, t, AliceOrBob);
+    for (i = NWORDS_ORDER-1; i >= 0; i--) {
+        if (s[i] != t[i]) return (s[i] > t[i]) ? 1 : -1;
+    }
+    return 0;
+}
+
+
+static void scalar_inv(const digit_t* a, digit_t* c, const unsigned int AliceOrBob)
+{ // c = a^(-1) mod order, for a unit a. Modulo 2^eA, Newton's iteration c = c*(2-a*c) doubles the number of
+  // correct bits, starting from a^(-1) = a mod 8.
+    digit_t t[NWORDS_ORDER] = {0}, two[NWORDS_ORDER] = {0};
+    unsigned int bits;
+
+    if (AliceOrBob == ALICE) {
+        two[0] = 2;
+        copy_words(a, c, NWORDS_ORDER);
+        for (bits = 3; bits < OALICE_BITS; bits *= 2) {
+            scalar_mul(a, c, t, ALICE);
+            scalar_sub(two, t, t, ALICE);
+            scalar_mul(c, t, c, ALICE);
+        }
+    } else {
+        to_Montgomery_mod_order(a, t, (digit_t*)Bob_order, (digit_t*)Montgomery_rprime, (digit_t*)Montgomery_Rprime);
+        Montgomery_inversion_mod_order_bingcd(t, t, (digit_t*)Bob_order, (digit_t*)Montgomery_rprime, (digit_t*)Montgomery_Rprime);
+        from_Montgomery_mod_order(t, c, (digit_t*)Bob_order, (digit_t*)Montgomery_rprime);
+    }
+}
+
+
+/********************************************************************************************
+* Deterministic basis of E_A[2^eA] (ALICE) or E_A[3^eB] (BOB)
+*********************************************************************************************/
+
+static bool torsion_basis(const f2elm_t A, const unsigned int AliceOrBob, point_t R1, point_t R2, f2elm_t xR1minusR2)
+{ // Points R1 and R2 of E_A: y^2 = x^3+A*x^2+x that generate the torsion subgroup of order 2^eA or 3^eB. They are
+  // the multiples by the cofactor of the first points with x = k+i, k = 1, 2, ..., that have full order and are
+  // independent, which is checked on [2^(eA-1)]R or [3^(eB-1)]R. Also returns x(R1-R2). Returns false if no basis is found.
+    point_proj_t R, T, T1;
+    f2elm_t x, f, t, A24plus, A24minus, C24 = {0}, one = {0};
+    unsigned int found = 0, tries = 0;
+
+    fpcopy((digit_t*)&Montgomery_one, one[0]);
+    fp2add(one, one, t);
+    fp2add(A, t, A24plus);                          // A24plus = A+2, A24minus = A-2, C24 = 4
+    fp2sub(A, t, A24minus);
+    fp2add(t, t, C24);
+    fpzero(x[0]);
+    fpcopy((digit_t*)&Montgomery_one, x[1]);
+
+    while (found < 2) {
+        if (++tries > TORSION_MAX_TRIES) return false;
+        fpadd(x[0], (digit_t*)&Montgomery_one, x[0]);
+        curve_rhs(x, A, f);
+        if (!fp2_is_square(f)) continue;       // x is on the twist
+
+        fp2copy(x, R->X);
+        fp2copy(one, R->Z);
+        if (AliceOrBob == ALICE) {
+            xTPLe(R, R, A24minus, A24plus, OBOB_EXPON);
+            xDBLe(R, T, A24plus, C24, OALICE_BITS-1);
+        } else {
+            xDBLe(R, R, A24plus, C24, OALICE_BITS);
+            xTPLe(R, T, A24minus, A24plus, OBOB_EXPON-1);
+        }
+        if (fp2is_zero_vartime(T->Z)) continue;     // R does not have full order
+
+        if (found == 0) {
+            fp2copy(T->X, T1->X);
+            fp2copy(T->Z, T1->Z);
+            fp2copy(R->X, R1->x);
+            fp2copy(R->Z, R1->y);
+            found = 1;
+        } else {
+            fp2mul_mont(T->X, T1->Z, f);
+            fp2mul_mont(T1->X, T->Z, t);
+            if (fp2equal_vartime(f, t)) continue;   // [2^(eA-1)]R or [3^(eB-1)]R is in the subgroup of [2^(eA-1)]R1 or [3^(eB-1)]R1
+            fp2copy(R->X, R2->x);
+            fp2copy(R->Z, R2->y);
+            found = 2;
+        }
+    }
+
+    fp2inv_mont_bingcd(R1->y);                      // Affine x, the root y is computed with fp2sqrt
+    fp2mul_mont(R1->x, R1->y, R1->x);
+    fp2inv_mont_bingcd(R2->y);
+    fp2mul_mont(R2->x, R2->y, R2->x);
+    curve_rhs(R1->x, A, f);
+    fp2sqrt(f, R1->y);
+    curve_rhs(R2->x, A, f);
+    fp2sqrt(f, R2->y);
+
+    fp2sub(R1->x, R2->x, t);                        // x(R1-R2) = ((y1+y2)/(x1-x2))^2-A-x1-x2
+    fp2inv_mont_bingcd(t);
+    fp2add(R1->y, R2->y, f);
+    fp2mul_mont(f, t, f);
+    fp2sqr_mont(f, f);
+    fp2sub(f, A, f);
+    fp2sub(f, R1->x, f);
+    fp2sub(f, R2->x, xR1minusR2);
+    return true;
+}
+
+
+/********************************************************************************************
+* Weil pairing and discrete logarithms in the subgroup of order 2^eA or 3^eB of GF(p^2)*
+*********************************************************************************************/
+
+static void miller_dbl(point_full_proj_t T, const f2elm_t A, const point_t* Q, const unsigned int nQ, f2elm_t* lnum, f2elm_t* lden, const unsigned int last)
+{ // Doubling step T <- 2T of the Miller loop, with the tangent line l and the vertical line v at 2T evaluated at the affine
+  // points Q[j], l(Q[j])/v(Q[j]) = lnum[j]/lden[j]. With last != 0 the ratio is not needed and lnum[j]/lden[j] = l(Q[j]),
+  // and T is not updated. With lambda = L/D, L = 3X^2+2AXZ+Z^2 and D = 2YZ:
+  // l/v = D*(D*(Z*y-Y)-L*(Z*x-X))/(x*D^2*Z-W), W = L^2*Z-(A*Z+2X)*D^2, and 2T = (W*D : L*(X*D^2-W)-Y*D^3 : D^3*Z).
+    f2elm_t L, D, D2, D2Z, W, t0, t1;
+    unsigned int j;
+
+    fp2sqr_mont(T->X, t0);                          // L = 3X^2+2AXZ+Z^2
+    fp2add(t0, t0, L);
+    fp2add(L, t0, L);
+    fp2mul_mont(T->X, T->Z, t0);
+    fp2mul_mont(t0, A, t0);
+    fp2add(t0, t0, t0);
+    fp2add(L, t0, L);
+    fp2sqr_mont(T->Z, t0);
+    fp2add(L, t0, L);
+    fp2mul_mont(T->Y, T->Z, D);                     // D = 2YZ
+    fp2add(D, D, D);
+
+    for (j = 0; j < nQ; j++) {
+        fp2mul_mont(T->Z, Q[j]->y, t0);             // lnum = D*(Z*y-Y)-L*(Z*x-X)
+        fp2sub(t0, T->Y, t0);
+        fp2mul_mont(D, t0, t0);
+        fp2mul_mont(T->Z, Q[j]->x, t1);
+        fp2sub(t1, T->X, t1);
+        fp2mul_mont(L, t1, t1);
+        fp2sub(t0, t1, lnum[j]);
+    }
+    if (last) {                                     // l = lnum/(D*Z)
+        fp2mul_mont(D, T->Z, t0);
+        for (j = 0; j < nQ; j++) {
+            fp2copy(t0, lden[j]);
+        }
+        return;
+    }
+
+    fp2sqr_mont(D, D2);                             // W = L^2*Z-(A*Z+2X)*D^2
+    fp2mul_mont(D2, T->Z, D2Z);
+    fp2sqr_mont(L, t0);
+    fp2mul_mont(t0, T->Z, W);
+    fp2mul_mont(A, T->Z, t0);
+    fp2add(t0, T->X, t0);
+    fp2add(t0, T->X, t0);
+    fp2mul_mont(t0, D2, t0);
+    fp2sub(W, t0, W);
+
+    for (j = 0; j < nQ; j++) {
+        fp2mul_mont(D, lnum[j], lnum[j]);           // l/v = D*lnum/(x*D^2*Z-W)
+        fp2mul_mont(Q[j]->x, D2Z, t0);
+        fp2sub(t0, W, lden[j]);
+    }
+
+    fp2mul_mont(T->X, D2, t0);                      // Y2 = L*(X*D^2-W)-Y*D^3
+    fp2sub(t0, W, t0);
+    fp2mul_mont(L, t0, t0);
+    fp2mul_mont(D2, D, D2);
+    fp2mul_mont(T->Y, D2, t1);
+    fp2sub(t0, t1, T->Y);
+    fp2mul_mont(W, D, T->X);                        // X2 = W*D, Z2 = D^3*Z
+    fp2mul_mont(D2, T->Z, T->Z);
+}
+
+
+static void miller_add(const point_full_proj_t T1, point_full_proj_t T2, const f2elm_t A, const point_t* Q, const unsigned int nQ, f2elm_t* lnum, f2elm_t* lden)
+{ // Addition step T2 <- T1+T2 of the Miller loop, with the line l through T1 and T2 and the vertical line v at T1+T2 evaluated
+  // at the affine points Q[j], l(Q[j])/v(Q[j]) = lnum[j]/lden[j]. With lambda = U/V, U = Y2*Z1-Y1*Z2, V = X2*Z1-X1*Z2:
+  // l/v = V*Z2*(V*(Z1*y-Y1)-U*(Z1*x-X1))/(x*V^2*Z1*Z2-W), W = U^2*Z1*Z2-(A*Z1*Z2+X1*Z2+X2*Z1)*V^2,
+  // and T1+T2 = (W*V : U*(X1*V^2*Z2-W)-Y1*V^3*Z2 : V^3*Z1*Z2).
+    f2elm_t U, V, V2, Z12, X1Z2, X2Z1, W, t0, t1;
+    unsigned int j;
+
+    fp2mul_mont(T2->Y, T1->Z, U);                   // U = Y2*Z1-Y1*Z2
+    fp2mul_mont(T1->Y, T2->Z, t0);
+    fp2sub(U, t0, U);
+    fp2mul_mont(T2->X, T1->Z, X2Z1);                // V = X2*Z1-X1*Z2
+    fp2mul_mont(T1->X, T2->Z, X1Z2);
+    fp2sub(X2Z1, X1Z2, V);
+    fp2mul_mont(T1->Z, T2->Z, Z12);
+    fp2sqr_mont(V, V2);
+
+    fp2sqr_mont(U, t0);                             // W = U^2*Z12-(A*Z12+X1*Z2+X2*Z1)*V^2
+    fp2mul_mont(t0, Z12, W);
+    fp2mul_mont(A, Z12, t0);
+    fp2add(t0, X1Z2, t0);
+    fp2add(t0, X2Z1, t0);
+    fp2mul_mont(t0, V2, t0);
+    fp2sub(W, t0, W);
+
+    fp2mul_mont(V, T2->Z, t1);                      // t1 = V*Z2
+    for (j = 0; j < nQ; j++) {
+        fp2mul_mont(T1->Z, Q[j]->y, t0);            // lnum = V*Z2*(V*(Z1*y-Y1)-U*(Z1*x-X1)), lden = x*V^2*Z12-W
+        fp2sub(t0, T1->Y, t0);
+        fp2mul_mont(V, t0, t0);
+        fp2mul_mont(T1->Z, Q[j]->x, lnum[j]);
+        fp2sub(lnum[j], T1->X, lnum[j]);
+        fp2mul_mont(U, lnum[j], lnum[j]);
+        fp2sub(t0, lnum[j], lnum[j]);
+        fp2mul_mont(t1, lnum[j], lnum[j]);
+        fp2mul_mont(V2, Z12, t0);
+        fp2mul_mont(Q[j]->x, t0, t0);
+        fp2sub(t0, W, lden[j]);
+    }
+
+    fp2mul_mont(X1Z2, V2, t0);                      // Y3 = U*(X1*Z2*V^2-W)-Y1*V^3*Z2
+    fp2sub(t0, W, t0);
+    fp2mul_mont(U, t0, t0);
+    fp2mul_mont(V2, t1, t1);
+    fp2mul_mont(T1->Y, t1, t1);
+    fp2sub(t0, t1, T2->Y);
+    fp2mul_mont(W, V, T2->X);                       // X3 = W*V, Z3 = V^3*Z12
+    fp2mul_mont(V2, V, t0);
+    fp2mul_mont(t0, Z12, T2->Z);
+}
+
+
+static void miller_loop(const point_t P, const point_t* Q, const unsigned int nQ, const f2elm_t A, const unsigned int AliceOrBob, f2elm_t* num, f2elm_t* den)
+{ // Miller function f_{n,P} of order n = 2^eA (ALICE) or n = 3^eB (BOB) evaluated at the points Q[j], f_{n,P}(Q[j]) = num[j]/den[j].
+  // f_{2m} = f_m^2*l_{mP,mP}/v_{2mP} and f_{3m} = f_m^3*l_{mP,mP}/v_{2mP}*l_{2mP,mP}/v_{3mP}. In the last step [n/2]P or [n/3]P
+  // has order 2 or 3, where the tangent line is vertical or goes through [2n/3]P = -[n/3]P, and the product reduces to l_{mP,mP}.
+    point_full_proj_t T, T2;
+    f2elm_t lnum[3], lden[3], lnum2[3], lden2[3], t;
+    unsigned int i, j, nsteps = (AliceOrBob == ALICE) ? OALICE_BITS : OBOB_EXPON;
+
+    fp2copy(P->x, T->X);
+    fp2copy(P->y, T->Y);
+    fp2zero(T->Z);
+    fpcopy((digit_t*)&Montgomery_one, T->Z[0]);
+    for (j = 0; j < nQ; j++) {
+        fp2copy(T->Z, num[j]);
+        fp2copy(T->Z, den[j]);
+    }
+
+    for (i = 0; i < nsteps; i++) {
+        if (AliceOrBob == ALICE) {
+            if (i == nsteps-1) {                    // T has order 2, l_{T,T} = x-x(T) and v_{2T} = 1
+                for (j = 0; j < nQ; j++) {
+                    fp2mul_mont(T->Z, Q[j]->x, lnum[j]);
+                    fp2sub(lnum[j], T->X, lnum[j]);
+                    fp2copy(T->Z, lden[j]);
+                }
+            } else {
+                miller_dbl(T, A, Q, nQ, lnum, lden, 0);
+            }
+            for (j = 0; j < nQ; j++) {
+                fp2sqr_mont(num[j], num[j]);
+                fp2mul_mont(num[j], lnum[j], num[j]);
+                fp2sqr_mont(den[j], den[j]);
+                fp2mul_mont(den[j], lden[j], den[j]);
+            }
+        } else {
+            if (i == nsteps-1) {                    // T has order 3
+                miller_dbl(T, A, Q, nQ, lnum, lden, 1);
+            } else {
+                fp2copy(T->X, T2->X);
+                fp2copy(T->Y, T2->Y);
+                fp2copy(T->Z, T2->Z);
+                miller_dbl(T2, A, Q, nQ, lnum, lden, 0);
+                miller_add(T2, T, A, Q, nQ, lnum2, lden2);
+                for (j = 0; j < nQ; j++) {
+                    fp2mul_mont(lnum[j], lnum2[j], lnum[j]);
+                    fp2mul_mont(lden[j], lden2[j], lden[j]);
+                }
+            }
+            for (j = 0; j < nQ; j++) {
+                fp2sqr_mont(num[j], t);
+                fp2mul_mont(num[j], t, num[j]);
+                fp2mul_mont(num[j], lnum[j], num[j]);
+                fp2sqr_mont(den[j], t);
+                fp2mul_mont(den[j], t, den[j]);
+                fp2mul_mont(den[j], lden[j], den[j]);
+            }
+        }
+    }
+}
+
+
+static void pow_ell(f2elm_t a, const unsigned int AliceOrBob)
+{ // a = a^2 (ALICE) or a = a^3 (BOB)
+    f2elm_t t;
+
+    if (AliceOrBob == ALICE) {
+        fp2sqr_mont(a, a);
+    } else {
+        fp2sqr_mont(a, t);
+        fp2mul_mont(a, t, a);
+    }
+}
+
+
+static void mul_conj(const f2elm_t a, const f2elm_t b, f2elm_t c)
+{ // c = a*conj(b). For b of norm 1, conj(b) = b^(-1)
+    f2elm_t t;
+
+    fp2copy(b, t);
+    fpneg(t[1]);
+    fp2mul_mont(a, t, c);
+}
+
+
+static bool dlog_digits(const f2elm_t h, const f2elm_t* G, const unsigned int AliceOrBob, const unsigned int len, unsigned char* digits)
+{ // Digits d[i] in base l = 2 (ALICE) or l = 3 (BOB) of the discrete logarithm of h in base G[e-len], where G[k] = g^(l^k), e = eA or eB,
+  // and h is in the subgroup of order l^len. h = G[e-len]^(x1+l^len1*x2) is split in x1 = log(h^(l^len2)) in base G[e-len1]
+  // and x2 = log(h*G[e-len]^(-x1)) in base G[e-len2], len = len1+len2.
+    unsigned int e = (AliceOrBob == ALICE) ? OALICE_BITS : OBOB_EXPON;
+    unsigned int i, j, len1, len2;
+    f2elm_t t, one = {0};
+
+    if (len == 1) {
+        fpcopy((digit_t*)&Montgomery_one, one[0]);
+        if (fp2equal_vartime(h, one)) {
+            digits[0] = 0;
+        } else if (fp2equal_vartime(h, G[e-1])) {
+            digits[0] = 1;
+        } else {
+            mul_conj(h, G[e-1], t);                 // h = G[e-1]^2 for l = 3
+            if (AliceOrBob == ALICE || !fp2equal_vartime(t, G[e-1])) return false;
+            digits[0] = 2;
+        }
+        return true;
+    }
+
+    len1 = len/2;
+    len2 = len - len1;
+    fp2copy(h, t);
+    for (i = 0; i < len2; i++) {
+        pow_ell(t, AliceOrBob);
+    }
+    if (!dlog_digits(t, G, AliceOrBob, len1, digits)) return false;
+
+    fp2copy(h, t);
+    for (i = 0; i < len1; i++) {
+        for (j = 0; j < digits[i]; j++) {
+            mul_conj(t, G[e-len+i], t);
+        }
+    }
+    return dlog_digits(t, G, AliceOrBob, len2, digits + len1);
+}
+
+
+static bool dlog(const f2elm_t h, const f2elm_t* G, const unsigned int AliceOrBob, digit_t* x)
+{ // Discrete logarithm x of h in base G[0] = g, x = sum d[i]*l^i
+    unsigned int e = (AliceOrBob == ALICE) ? OALICE_BITS : OBOB_EXPON;
+    unsigned char digits[DLOG_MAX_DIGITS];
+    digit_t t[NWORDS_ORDER], d[NWORDS_ORDER] = {0};
+    int i;
+
+    if (!dlog_digits(h, G, AliceOrBob, e, digits)) return false;
+
+    memset(x, 0, NWORDS_ORDER*sizeof(digit_t));
+    for (i = (int)e-1; i >= 0; i--) {
+        copy_words(x, t, NWORDS_ORDER);
+        mp_shiftl1(x, NWORDS_ORDER);
+        if (AliceOrBob == BOB) {
+            mp_add(x, t, x, NWORDS_ORDER);
+        }
+        d[0] = digits[i];
+        mp_add(x, d, x, NWORDS_ORDER);
+    }
+    return true;
+}
+
+
+/********************************************************************************************
+* Compression and decompression
+*********************************************************************************************/
+
+static int compress_public_key(const unsigned char* PublicKey, unsigned char* CompressedPK, const unsigned int AliceOrBob, const bool exact)
+{ // Public key x(P), x(Q), x(P-Q) with P, Q in E_A[2^eA] (ALICE) or E_A[3^eB] (BOB) to A and the coordinates a0, b0, a1, b1 of
+  // P = a0*R1+b0*R2 and Q = a1*R1+b1*R2 if exact = true, or to A, the bit b and the scalars s0, s1, s2 otherwise. Exact coordinates
+  // are negated, as P, Q and -P, -Q have the same public key, unless the first nonzero one of a0, b0 is smaller than its negative.
+  // Otherwise, if a0 is a unit, b = 0 and (s0, s1, s2) = (b0, a1, b1)/a0, else b0 is a unit, b = 1 and (s0, s1, s2) = (a0, b1, a1)/b0.
+  // The coordinates are obtained from the Weil pairing e: with g = e(R1,R2), e(R1,P) = g^b0, e(R2,P) = g^-a0, e(R1,Q) = g^b1 and
+  // e(R2,Q) = g^-a1. Exact coordinates are only used for the odd order 3^eB.
+  // Returns 1 if a pairing is degenerate, which has negligible probability for an honest public key.
+    unsigned int e = (AliceOrBob == ALICE) ? OALICE_BITS : OBOB_EXPON, nbytes = (AliceOrBob == ALICE) ? SECRETKEY_A_BYTES : SECRETKEY_B_BYTES;
+    point_t pts[4], R1Q[3], R2Q[3], PQ[2];
+    f2elm_t xP, xQ, xR, A, xD, t0, t1, num[4][3], den[4][3], pnum[5], pden[5], pinv[5], G[DLOG_MAX_DIGITS], one = {0};
+    digit_t a0[NWORDS_ORDER], b0[NWORDS_ORDER], a1[NWORDS_ORDER], b1[NWORDS_ORDER], inv[NWORDS_ORDER], s[NWORDS_ORDER], zero[NWORDS_ORDER] = {0};
+    unsigned int i, bit;
+    int sign;
+
+    fp2_decode(PublicKey, xP);
+    fp2_decode(PublicKey + FP2_ENCODED_BYTES, xQ);
+    fp2_decode(PublicKey + 2*FP2_ENCODED_BYTES, xR);
+    get_A(xP, xQ, xR, A);
+
+    // P = (xP, yP) and Q = (xQ, yQ) with x(P-Q) = xR: yP*yQ = ((xR+A+xP+xQ)*(xP-xQ)^2-yP^2-yQ^2)/2
+    fp2copy(xP, pts[2]->x);
+    fp2copy(xQ, pts[3]->x);
+    curve_rhs(xP, A, t0);
+    if (!fp2_is_square(t0)) return 1;
+    fp2sqrt(t0, pts[2]->y);
+    curve_rhs(xQ, A, t1);
+    fp2add(t0, t1, t1);
+    fp2add(xR, A, t0);
+    fp2add(t0, xP, t0);
+    fp2add(t0, xQ, t0);
+    fp2sub(xP, xQ, pts[3]->y);
+    fp2sqr_mont(pts[3]->y, pts[3]->y);
+    fp2mul_mont(t0, pts[3]->y, t0);
+    fp2sub(t0, t1, t0);
+    fp2add(pts[2]->y, pts[2]->y, t1);
+    fp2inv_mont_bingcd(t1);
+    fp2mul_mont(t0, t1, pts[3]->y);
+
+    if (!torsion_basis(A, AliceOrBob, pts[0], pts[1], xD)) return 1;
+
+    // Miller functions of R1 at R2, P, Q, of R2 at R1, P, Q, of P at R1, R2 and of Q at R1, R2
+    memcpy(R1Q[0], pts[1], sizeof(point_t));
+    memcpy(R1Q[1], pts[2], sizeof(point_t));
+    memcpy(R1Q[2], pts[3], sizeof(point_t));
+    memcpy(R2Q[0], pts[0], sizeof(point_t));
+    memcpy(R2Q[1], pts[2], sizeof(point_t));
+    memcpy(R2Q[2], pts[3], sizeof(point_t));
+    memcpy(PQ[0], pts[0], sizeof(point_t));
+    memcpy(PQ[1], pts[1], sizeof(point_t));
+    miller_loop(pts[0], R1Q, 3, A, AliceOrBob, num[0], den[0]);
+    miller_loop(pts[1], R2Q, 3, A, AliceOrBob, num[1], den[1]);
+    miller_loop(pts[2], PQ, 2, A, AliceOrBob, num[2], den[2]);
+    miller_loop(pts[3], PQ, 2, A, AliceOrBob, num[3], den[3]);
+
+    // Weil pairings e(S,T) = (-1)^n*f_S(T)/f_T(S): e(R1,R2), e(R1,P), e(R2,P), e(R1,Q), e(R2,Q)
+    fp2mul_mont(num[0][0], den[1][0], pnum[0]);
+    fp2mul_mont(den[0][0], num[1][0], pden[0]);
+    fp2mul_mont(num[0][1], den[2][0], pnum[1]);
+    fp2mul_mont(den[0][1], num[2][0], pden[1]);
+    fp2mul_mont(num[1][1], den[2][1], pnum[2]);
+    fp2mul_mont(den[1][1], num[2][1], pden[2]);
+    fp2mul_mont(num[0][2], den[3][0], pnum[3]);
+    fp2mul_mont(den[0][2], num[3][0], pden[3]);
+    fp2mul_mont(num[1][2], den[3][1], pnum[4]);
+    fp2mul_mont(den[1][2], num[3][1], pden[4]);
+    for (i = 0; i < 5; i++) {
+        if (fp2is_zero_vartime(pnum[i]) || fp2is_zero_vartime(pden[i])) return 1;
+    }
+    fpcopy((digit_t*)&Montgomery_one, one[0]);
+    mont_n_way_inv_bingcd((const f2elm_t*)pden, 5, pinv, one);
+    for (i = 0; i < 5; i++) {
+        fp2mul_mont(pnum[i], pinv[i], pnum[i]);
+        if (AliceOrBob == BOB) fp2neg(pnum[i]);
+    }
+
+    // G[k] = g^(l^k), g must have order l^e
+    fp2copy(pnum[0], G[0]);
+    for (i = 1; i < e; i++) {
+        fp2copy(G[i-1], G[i]);
+        pow_ell(G[i], AliceOrBob);
+    }
+    if (fp2equal_vartime(G[e-1], one)) return 1;
+
+    mul_conj(one, pnum[2], t0);                     // e(R2,P)^-1 = g^a0, e(R2,Q)^-1 = g^a1
+    mul_conj(one, pnum[4], t1);
+    if (!dlog(pnum[1], (const f2elm_t*)G, AliceOrBob, b0) || !dlog(t0, (const f2elm_t*)G, AliceOrBob, a0) ||
+        !dlog(pnum[3], (const f2elm_t*)G, AliceOrBob, b1) || !dlog(t1, (const f2elm_t*)G, AliceOrBob, a1)) return 1;
+
+    fp2_encode(A, CompressedPK);
+    if (exact) {
+        sign = scalar_sign(a0, AliceOrBob);
+        if (sign == 0) sign = scalar_sign(b0, AliceOrBob);
+        if (sign == 0) return 1;
+        if (sign > 0) {                             // (a0, b0, a1, b1) = -(a0, b0, a1, b1)
+            scalar_sub(zero, a0, a0, AliceOrBob);
+            scalar_sub(zero, b0, b0, AliceOrBob);
+            scalar_sub(zero, a1, a1, AliceOrBob);
+            scalar_sub(zero, b1, b1, AliceOrBob);
+        }
+        scalar_encode(a0, CompressedPK + FP2_ENCODED_BYTES, AliceOrBob);
+        scalar_encode(b0, CompressedPK + FP2_ENCODED_BYTES + nbytes, AliceOrBob);
+        scalar_encode(a1, CompressedPK + FP2_ENCODED_BYTES + 2*nbytes, AliceOrBob);
+        scalar_encode(b1, CompressedPK + FP2_ENCODED_BYTES + 3*nbytes, AliceOrBob);
+        return 0;
+    }
+
+    bit = !scalar_is_unit(a0, AliceOrBob);
+    if (bit) {
+        if (!scalar_is_unit(b0, AliceOrBob)) return 1;
+        copy_words(a0, s, NWORDS_ORDER);            // (s0, s1, s2) = (a0, b1, a1)/b0
+        copy_words(b0, a0, NWORDS_ORDER);
+        copy_words(s, b0, NWORDS_ORDER);
+        copy_words(a1, s, NWORDS_ORDER);
+        copy_words(b1, a1, NWORDS_ORDER);
+        copy_words(s, b1, NWORDS_ORDER);
+    }
+    scalar_inv(a0, inv, AliceOrBob);
+
+    scalar_mul(b0, inv, s, AliceOrBob);
+    scalar_encode(s, CompressedPK + FP2_ENCODED_BYTES, AliceOrBob);
+    scalar_mul(a1, inv, s, AliceOrBob);
+    scalar_encode(s, CompressedPK + FP2_ENCODED_BYTES + nbytes, AliceOrBob);
+    scalar_mul(b1, inv, s, AliceOrBob);
+    scalar_encode(s, CompressedPK + FP2_ENCODED_BYTES + 2*nbytes, AliceOrBob);
+    CompressedPK[FP2_ENCODED_BYTES + 3*nbytes] = (unsigned char)bit;
+
+    return 0;
+}
+
+
+static void xMUL_vartime(const f2elm_t xP, const digit_t* k, const f2elm_t A, point_proj_t R)
+{ // Montgomery ladder R = [k]P for a public k >= 1, with the affine x-coordinate xP
+    point_proj_t R1;
+    f2elm_t A24plus = {0}, C24 = {0}, A24;
+    int i = NWORDS_ORDER*RADIX-1;
+
+    fpcopy((digit_t*)&Montgomery_one, C24[0]);
+    fp2add(C24, C24, C24);
+    fp2add(A, C24, A24plus);                        // A24plus = A+2, C24 = 4, A24 = (A+2)/4
+    fp2add(C24, C24, C24);
+    fp2div2(A24plus, A24);
+    fp2div2(A24, A24);
+
+    while (i > 0 && ((k[i >> LOG2RADIX] >> (i & (RADIX-1))) & 1) == 0) i--;
+    fp2copy(xP, R->X);
+    fp2zero(R->Z);
+    fpcopy((digit_t*)&Montgomery_one, R->Z[0]);
+    if (i == 0) return;
+
+    xDBL(R, R1, A24plus, C24);
+    for (i = i-1; i >= 0; i--) {
+        if ((k[i >> LOG2RADIX] >> (i & (RADIX-1))) & 1) {
+            xDBLADD(R1, R, xP, A24);                // (R, R1) = (R+R1, 2R1)
+        } else {
+            xDBLADD(R, R1, xP, A24);                // (R, R1) = (2R, R+R1)
+        }
+    }
+}
+
+
+static bool mul_2d(const f2elm_t xB1, const f2elm_t xB2, const f2elm_t xD, const digit_t* u, const digit_t* v, const f2elm_t A, const unsigned int AliceOrBob, point_proj_t R)
+{ // x(u*B1+v*B2) = x([u](B1+(v/u)*B2)) if u is a unit, or x([v](B2+(u/v)*B1)) otherwise, with xD = x(B1-B2)
+    digit_t w[NWORDS_ORDER];
+    f2elm_t x;
+
+    if (scalar_is_unit(u, AliceOrBob)) {
+        scalar_inv(u, w, AliceOrBob);
+        scalar_mul(v, w, w, AliceOrBob);
+        LADDER3PT(xB1, xB2, xD, w, AliceOrBob, R, A);
+    } else if (scalar_is_unit(v, AliceOrBob)) {
+        scalar_inv(v, w, AliceOrBob);
+        scalar_mul(u, w, w, AliceOrBob);
+        LADDER3PT(xB2, xB1, xD, w, AliceOrBob, R, A);
+        u = v;
+    } else {
+        return false;
+    }
+    fp2inv_mont_bingcd(R->Z);
+    fp2mul_mont(R->X, R->Z, x);
+    xMUL_vartime(x, u, A, R);
+    return true;
+}
+
+
+static int decompress_public_key(const unsigned char* CompressedPK, unsigned char* PublicKey, const unsigned int AliceOrBob, const bool exact)
+{ // Compressed public key to x(P), x(Q), x(P-Q) if exact = true, with P = a0*R1+b0*R2 and Q = a1*R1+b1*R2. Otherwise, to x(cP), x(cQ),
+  // x(cP-cQ), c = a0^-1 or c = b0^-1: with B1 = R1, B2 = R2 if b = 0 and B1 = R2, B2 = R1 if b = 1, cP = B1+s0*B2, cQ = s1*B1+s2*B2
+  // and cP-cQ = (1-s1)*B1+(s0-s2)*B2.
+  // Returns 1 if the compressed public key is malformed, including exact coordinates with the other sign than the one of compression.
+    unsigned int nbytes = (AliceOrBob == ALICE) ? SECRETKEY_A_BYTES : SECRETKEY_B_BYTES, bit = 0;
+    point_t R1, R2;
+    point_proj_t R[3];
+    f2elm_t A, xD, z[3], zinv[3], one_fp2 = {0};
+    digit_t c[4][NWORDS_ORDER], u[NWORDS_ORDER], v[NWORDS_ORDER];    // P or cP = c[0]*B1+c[1]*B2, Q or cQ = c[2]*B1+c[3]*B2
+    unsigned int i;
+    int sign;
+
+    if (exact) {
+        for (i = 0; i < 4; i++) {
+            scalar_decode(CompressedPK + FP2_ENCODED_BYTES + i*nbytes, c[i], AliceOrBob);
+            if (!scalar_is_valid(c[i], AliceOrBob)) return 1;
+        }
+        sign = scalar_sign(c[0], AliceOrBob);
+        if (sign == 0) sign = scalar_sign(c[1], AliceOrBob);
+        if (sign >= 0) return 1;
+    } else {
+        bit = CompressedPK[FP2_ENCODED_BYTES + 3*nbytes];
+        memset(c[0], 0, sizeof(c[0]));
+        c[0][0] = 1;
+        for (i = 1; i < 4; i++) {
+            scalar_decode(CompressedPK + FP2_ENCODED_BYTES + (i-1)*nbytes, c[i], AliceOrBob);
+            if (!scalar_is_valid(c[i], AliceOrBob)) return 1;
+        }
+        if (bit > 1) return 1;
+    }
+    fp2_decode(CompressedPK, A);
+
+    if (!torsion_basis(A, AliceOrBob, R1, R2, xD)) return 1;
+    if (bit) {
+        memcpy(R[0], R1, sizeof(point_t));
+        memcpy(R1, R2, sizeof(point_t));
+        memcpy(R2, R[0], sizeof(point_t));
+    }
+
+    if (!mul_2d(R1->x, R2->x, xD, c[0], c[1], A, AliceOrBob, R[0])) return 1;
+    if (!mul_2d(R1->x, R2->x, xD, c[2], c[3], A, AliceOrBob, R[1])) return 1;
+    scalar_sub(c[0], c[2], u, AliceOrBob);
+    scalar_sub(c[1], c[3], v, AliceOrBob);
+    if (!mul_2d(R1->x, R2->x, xD, u, v, A, AliceOrBob, R[2])) return 1;
+
+    for (i = 0; i < 3; i++) {
+        if (fp2is_zero_vartime(R[i]->Z)) return 1;
+        fp2copy(R[i]->Z, z[i]);
+    }
+    fpcopy((digit_t*)&Montgomery_one, one_fp2[0]);
+    mont_n_way_inv_bingcd((const f2elm_t*)z, 3, zinv, one_fp2);
+    for (i = 0; i < 3; i++) {
+        fp2mul_mont(R[i]->X, zinv[i], R[i]->X);
+        fp2_encode(R[i]->X, PublicKey + i*FP2_ENCODED_BYTES);
+    }
+    return 0;
+}
+
+
+int PublicKeyCompression_A(const unsigned char* PublicKeyA, unsigned char* CompressedPKA)
+{ // Alice's public key compression
+  // Input:  Alice's public key PublicKeyA, the images of Bob's basis of E[3^eB].
+  // Output: the compressed public key CompressedPKA, A in GF(p^2) and 4 scalars modulo 3^eB of SECRETKEY_B_BYTES bytes.
+  // Returns 1 in the negligible case that the public key does not have a compressed form, 0 otherwise.
+    return compress_public_key(PublicKeyA, CompressedPKA, BOB, true);
+}
+
+
+int PublicKeyCompression_B(const unsigned char* PublicKeyB, unsigned char* CompressedPKB)
+{ // Bob's public key compression
+  // Input:  Bob's public key PublicKeyB, the images of Alice's basis of E[2^eA].
+  // Output: the compressed public key CompressedPKB, A in GF(p^2) and 3 scalars modulo 2^eA of SECRETKEY_A_BYTES bytes and 1 byte.
+  // Returns 1 in the negligible case that the public key does not have a compressed form, 0 otherwise.
+    return compress_public_key(PublicKeyB, CompressedPKB, ALICE, false);
+}
+
+
+int PublicKeyDecompression_A(const unsigned char* CompressedPKA, unsigned char* PublicKeyA)
+{ // Alice's public key decompression
+  // Input:  Alice's compressed public key CompressedPKA.
+  // Output: Alice's public key PublicKeyA.
+  // Returns 1 if CompressedPKA is malformed, 0 otherwise.
+    return decompress_public_key(CompressedPKA, PublicKeyA, BOB, true);
+}
+
+
+int PublicKeyDecompression_B(const unsigned char* CompressedPKB, unsigned char* PublicKeyB)
+{ // Bob's public key decompression
+  // Input:  Bob's compressed public key CompressedPKB.
+  // Output: a public key PublicKeyB that gives the same shared secret as the uncompressed one in EphemeralSecretAgreement_A.
+  // Returns 1 if CompressedPKB is malformed, 0 otherwise.
+    return decompress_public_key(CompressedPKB, PublicKeyB, ALICE, false);
+}
@@ -0,0 +1,349 @@
+/********************************************************************************************
+* Supersingular Isogeny Key Encapsulation Library
+*
+* Abstract: generator of the strategies for the isogeny tree traversal on one or several cores,
+*           for a SIDH prime p = 2^eA*3^eB-1.
+*
+* Usage:    gen_strategy [-s] [-c xDBL xTPL get4 eval4 get3 eval3] eA eB ptsA ptsB cores... > strat_parallel.c
+*           emits one table per number of cores, for _ISOG_THREADS_ == cores, or the sequential build for 1.
+*           ptsA and ptsB bound the number of points kept by the traversal (MAX_INT_POINTS_ALICE/BOB).
+*           -c gives the costs of the curve and isogeny functions, e.g., measured by tools/tune_strategy.c,
+*           by default their number of multiplications in GF(p) (3 per multiplication and 2 per squaring
+*           in GF(p^2)).
+*           -s emits the tables indexed by the size of the subtree (SIKEp964) instead of the
+*           list of splits in the order of the traversal.
+*
+* With ISOG_THREADS=k the points of every row are evaluated by k-1 workers and the calling thread
+* (see sidh.c), while the calling thread also runs the xDBLe/xTPLe chain of the next row. The cost
+* of a strategy is no longer a sum over the tree, so the strategies are ranked by a simulation of
+* the traversal on k cores instead. The search starts from the best of the sequential strategy and
+* of the optimal sequential strategies for a range of scaled evaluation costs, all of them with at
+* most ptsA/ptsB points, and then moves single splits while the simulated cost of key generation
+* plus shared secret decreases. The result is a local optimum of the simulation, never worse than
+* the sequential strategy. On one core the simulated cost is the usual sum over the tree and the
+* search returns the optimal sequential strategy for the given costs.
+*********************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+
+#define MAX_LEAVES        512
+#define MAX_POINTS        32
+#define MAX_CORES         16
+#define MAX_MOVE          4                     // Largest change of one split in the local search
+
+typedef struct {
+    const char* name;                           // "Alice" or "Bob"
+    int leaves;                                 // Isogenies of the traversal, MAX_Alice or MAX_Bob
+    int maxpts;                                 // MAX_INT_POINTS_ALICE or MAX_INT_POINTS_BOB
+    double step, get, eval;                     // Costs of one multiplication step (2 xDBL or 1 xTPL), get_isog and eval_isog
+} party_t;
+
+typedef struct {
+    int split[MAX_LEAVES+1][MAX_POINTS+1];      // Split of a subtree with n leaves and d free points, 1 <= split[n][d] < n
+    double cost;
+} strategy_t;
+
+static int by_size = 0;                         // Splits only depend on the size of the subtree
+
+
+static int strategy_list(const strategy_t* S, int n, int d, int* list, int* k)
+{ // The splits in the order of the traversal: [s] + list(n-s, d-1) + list(s, d). Returns 0 if more than d points are needed.
+    int s = S->split[n][d];
+
+    if (n < 2) return 1;
+    if (d < 1) return 0;
+    list[(*k)++] = s;
+    return strategy_list(S, n - s, d - 1, list, k) && strategy_list(S, s, d, list, k);
+}
+
+
+static double schedule(int ntasks, double start, double main, double* workers, int nworkers, double eval)
+{ // Evaluations of one row, started at the end of the row and claimed by the first free thread.
+  // The calling thread helps from "main" on, the result is the end of the row barrier.
+    double end = main, t;
+    int i, j, best;
+
+    for (i = 0; i < ntasks; i++) {
+        best = -1;
+        t = main;
+        for (j = 0; j < nworkers; j++) {
+            double w = (workers[j] > start) ? workers[j] : start;
+            if (w < t) { t = w; best = j; }
+        }
+        t += eval;
+        if (best < 0) main = t; else workers[best] = t;
+        if (t > end) end = t;
+    }
+    return end;
+}
+
+
+static double simulate(const party_t* P, const int* list, int cores, int phi)
+{ // Time of the traversal of sidh.c on "cores" threads, with "phi" images of the basis points
+    double t = 0, start = 0, workers[MAX_CORES];
+    int row, m, index = 0, ii = 0, npts = 0, pts_index[MAX_LEAVES], ntasks = 0, j;
+
+    for (j = 0; j < cores - 1; j++) workers[j] = 0;
+    for (row = 1; row < P->leaves; row++) {
+        while (index < P->leaves - row) {
+            pts_index[npts++] = index;
+            m = list[ii++];
+            t += m*P->step;
+            index += m;
+        }
+        t += P->get;
+        t = schedule(ntasks, start, t, workers, cores - 1, P->eval);
+        t += P->eval;                           // Next kernel point on the calling thread
+        ntasks = npts - 1 + phi;
+        start = t;
+        index = pts_index[npts-1];
+        npts -= 1;
+    }
+    t = schedule(ntasks, start, t, workers, cores - 1, P->eval);
+    return t + P->get + phi*P->eval;
+}
+
+
+static void strategy_cost(const party_t* P, strategy_t* S, int cores)
+{ // Key generation (3 images) plus shared secret (no images), infinite if the traversal keeps too many points
+    int list[MAX_LEAVES], k = 0;
+
+    if (!strategy_list(S, P->leaves, P->maxpts, list, &k)) {
+        S->cost = HUGE_VAL;
+        return;
+    }
+    S->cost = simulate(P, list, cores, 3) + simulate(P, list, cores, 0);
+}
+
+
+static void strategy_optimal(const party_t* P, double eval, strategy_t* S)
+{ // Optimal sequential strategy for an evaluation cost "eval" and at most d points:
+  // C(n, d) = min C(n-s, d-1) + C(s, d) + s*step + (n-s)*eval. With by_size, C(n) ignores d.
+    static double C[MAX_LEAVES+1][MAX_POINTS+1];
+    double c;
+    int n, d, s;
+
+    for (d = 0; d <= P->maxpts; d++) C[1][d] = 0;
+    for (n = 2; n <= P->leaves; n++) {
+        for (d = 0; d <= P->maxpts; d++) {
+            C[n][d] = HUGE_VAL;
+            S->split[n][d] = 1;
+            if (by_size && d > 0) {
+                C[n][d] = C[n][0];
+                S->split[n][d] = S->split[n][0];
+                continue;
+            }
+            if (d == 0 && !by_size) continue;
+            for (s = 1; s < n; s++) {
+                c = C[n-s][by_size ? 0 : d-1] + C[s][d] + s*P->step + (n-s)*eval;
+                if (c < C[n][d]) {
+                    C[n][d] = c;
+                    S->split[n][d] = s;
+                }
+            }
+        }
+    }
+}
+
+
+static void strategy_move(strategy_t* S, int n, int d, int s)
+{
+    int i;
+
+    if (by_size) {
+        for (i = 0; i <= MAX_POINTS; i++) S->split[n][i] = s;
+    } else {
+        S->split[n][d] = s;
+    }
+}
+
+
+static void strategy_search(const party_t* P, int cores, const strategy_t* seed, strategy_t* best)
+{ // Best of "seed" and of the optimal sequential strategies for scaled evaluation costs, then moves of single splits
+    static strategy_t S;
+    static int used[MAX_LEAVES+1][MAX_POINTS+1];
+    double scale, cost;
+    int n, d, s, m, improved;
+
+    best->cost = HUGE_VAL;
+    if (seed != NULL) {
+        *best = *seed;
+        strategy_cost(P, best, cores);
+    }
+    strategy_optimal(P, P->eval, &S);
+    strategy_cost(P, &S, cores);
+    if (S.cost < best->cost) *best = S;
+    for (scale = 4.0; scale > 0.01; scale *= 0.97) {
+        strategy_optimal(P, scale*P->eval, &S);
+        strategy_cost(P, &S, cores);
+        if (S.cost < best->cost) *best = S;
+    }
+    if (best->cost == HUGE_VAL) return;
+
+    do {
+        improved = 0;
+        memset(used, 0, sizeof(used));          // Subtrees reached by the current strategy
+        used[P->leaves][P->maxpts] = 1;
+        for (n = P->leaves; n >= 2; n--) {
+            for (d = 1; d <= P->maxpts; d++) {
+                if (!used[n][d]) continue;
+                s = best->split[n][d];
+                used[n-s][d-1] = used[s][d] = 1;
+            }
+        }
+        for (n = 2; n <= P->leaves; n++) {
+            for (d = 1; d <= P->maxpts; d++) {
+                if (!used[n][d]) continue;
+                s = best->split[n][d];
+                for (m = -MAX_MOVE; m <= MAX_MOVE; m++) {
+                    if (m == 0 || s + m < 1 || s + m >= n) continue;
+                    cost = best->cost;
+                    strategy_move(best, n, d, s + m);
+                    strategy_cost(P, best, cores);
+                    if (best->cost < cost) {
+                        s += m;
+                        improved = 1;
+                    } else {
+                        strategy_move(best, n, d, s);
+                        best->cost = cost;
+                    }
+                }
+                if (by_size) break;
+            }
+        }
+    } while (improved);
+}
+
+
+static void emit_table(const party_t* P, const strategy_t* S)
+{
+    int list[MAX_LEAVES], k = 0, i, len;
+    char buf[16];
+
+    if (by_size) {
+        list[k++] = 0;
+        for (i = 2; i <= P->leaves; i++) list[k++] = S->split[i][0];
+        printf("const unsigned int strat_%s[MAX_%s] = {\n", P->name, P->name);
+    } else {
+        strategy_list(S, P->leaves, P->maxpts, list, &k);
+        printf("const unsigned int strat_%s[MAX_%s-1] = { \n", P->name, P->name);
+    }
+    for (i = 0, len = 0; i < k; i++) {
+        sprintf(buf, "%d%s", list[i], (i < k-1) ? ", " : " };\n");
+        if (len + strlen(buf) > 82) {
+            printf("\n");
+            len = 0;
+        }
+        printf("%s", buf);
+        len += (int)strlen(buf);
+    }
+}
+
+
+static int read_costs(char** argv, double* c)
+{
+    int i;
+
+    for (i = 0; i < 6; i++) {
+        c[i] = atof(argv[i]);
+        if (c[i] <= 0) return 0;
+    }
+    return 1;
+}
+
+
+int main(int argc, char** argv)
+{
+    static strategy_t best[2][MAX_CORES], sequential;
+    double sequential_cost[2][MAX_CORES];
+    double costs[6] = { 4*3 + 2*2, 4*3 + 5*2, 4*2, 4*3 + 2*2, 2*3 + 3*2, 2*3 + 2*2 };   // xDBL, xTPL, get4, eval4, get3, eval3
+    int default_costs = 1, eA, eB, pbits, ncores, cores[MAX_CORES], i, j;
+    party_t party[2];
+
+    argv++; argc--;
+    while (argc > 0 && argv[0][0] == '-') {
+        if (strcmp(argv[0], "-s") == 0) {
+            by_size = 1;
+            argv++; argc--;
+        } else if (strcmp(argv[0], "-c") == 0 && argc >= 7 && read_costs(argv + 1, costs)) {
+            default_costs = 0;
+            argv += 7; argc -= 7;
+        } else {
+            argc = 0;
+        }
+    }
+    if (argc < 5 || argc - 4 > MAX_CORES) {
+        fprintf(stderr, "Usage: gen_strategy [-s] [-c xDBL xTPL get4 eval4 get3 eval3] eA eB ptsA ptsB cores...\n");
+        return 1;
+    }
+    eA = atoi(argv[0]);
+    eB = atoi(argv[1]);
+    party[0] = (party_t){ "Alice", eA/2, atoi(argv[2]), 2*costs[0], costs[2], costs[3] };
+    party[1] = (party_t){ "Bob", eB, atoi(argv[3]), costs[1], costs[4], costs[5] };
+    ncores = argc - 4;
+    for (i = 0; i < ncores; i++) {
+        cores[i] = atoi(argv[4 + i]);
+        if (cores[i] < 1 || cores[i] > MAX_CORES) {
+            fprintf(stderr, "Unsupported number of cores %s\n", argv[4 + i]);
+            return 1;
+        }
+    }
+    if (eA < 4 || eB < 2 || eA/2 > MAX_LEAVES || eB > MAX_LEAVES || party[0].maxpts < 1 || party[1].maxpts < 1) {
+        fprintf(stderr, "Unsupported parameters eA = %d, eB = %d, ptsA = %d, ptsB = %d\n", eA, eB, party[0].maxpts, party[1].maxpts);
+        return 1;
+    }
+    pbits = (int)floor(eA + eB*log2(3.0)) + 1;
+
+    for (i = 0; i < 2; i++) {
+        strategy_search(&party[i], 1, NULL, &sequential);
+        if (sequential.cost == HUGE_VAL) {
+            fprintf(stderr, "No strategy for %s with at most %d points\n", party[i].name, party[i].maxpts);
+            return 1;
+        }
+        for (j = 0; j < ncores; j++) {
+            strategy_search(&party[i], cores[j], &sequential, &best[i][j]);
+            strategy_cost(&party[i], &sequential, cores[j]);
+            sequential_cost[i][j] = sequential.cost;
+            fprintf(stderr, "p%d, %s, %d core%s: simulated cost %.0f, sequential strategy %.0f (%.1f%% less)\n",
+                    pbits, party[i].name, cores[j], (cores[j] > 1) ? "s" : "", best[i][j].cost, sequential_cost[i][j],
+                    100*(1 - best[i][j].cost/sequential_cost[i][j]));
+        }
+    }
+
+    printf("/********************************************************************************************\n");
+    printf("* Supersingular Isogeny Key Encapsulation Library\n");
+    printf("*\n");
+    printf("* Abstract: strategies for the isogeny tree traversal in p%d = 2^%d*3^%d-1\n", pbits, eA, eB);
+    printf("*           Generated by tools/gen_strategy.c, do not edit.\n");
+    printf("*\n");
+    if (default_costs) {
+        printf("* Costs in multiplications in GF(p): xDBL %.0f, xTPL %.0f, get_4_isog %.0f, eval_4_isog %.0f,\n", costs[0], costs[1], costs[2], costs[3]);
+        printf("* get_3_isog %.0f, eval_3_isog %.0f. Simulated key generation plus shared secret:\n", costs[4], costs[5]);
+    } else {
+        printf("* Costs: xDBL %g, xTPL %g, get_4_isog %g, eval_4_isog %g, get_3_isog %g, eval_3_isog %g.\n", costs[0], costs[1], costs[2], costs[3], costs[4], costs[5]);
+        printf("* Simulated key generation plus shared secret:\n");
+    }
+    for (j = 0; j < ncores; j++) {
+        printf("* %d core%s Alice %.0f (sequential strategy %.0f), Bob %.0f (%.0f)\n", cores[j], (cores[j] > 1) ? "s:" : ": ",
+               best[0][j].cost, sequential_cost[0][j], best[1][j].cost, sequential_cost[1][j]);
+    }
+    printf("*********************************************************************************************/\n\n");
+    for (j = 0; j < ncores; j++) {
+        if (cores[j] == 1) {
+            printf("%s !defined(_ISOG_THREADS_)\n", (j == 0) ? "#if" : "#elif");
+        } else {
+            printf("%s (_ISOG_THREADS_ == %d)\n", (j == 0) ? "#if" : "#elif", cores[j]);
+        }
+        emit_table(&party[0], &best[0][j]);
+        printf("\n");
+        emit_table(&party[1], &best[1][j]);
+    }
+    printf("#else\n");
+    printf("    #error -- \"No strategy for _ISOG_THREADS_ cores\"\n");
+    printf("#endif\n");
+    return 0;
+}
@@ -82,6 +82,12 @@ void mp_mul(const digit_t* a, const digit_t* b, digit_t* c, const unsigned int n
     mul751_asm(a, b, c);
 }
 
+void mp_sqr(const digit_t* a, digit_t* c, const unsigned int nwords)
+{ // Multiprecision comba squaring, c = a^2, where lng(a) = nwords.
+    UNREFERENCED_PARAMETER(nwords);
+    sqr751_asm(a, c);
+}
+
 
 
 void rdc_mont(const digit_t* ma, digit_t* mc)
@@ -51,6 +51,58 @@ int crypto_kem_dec(unsigned char *ss, const unsigned char *ct, const unsigned ch
 // Shared keys ss consist of a value of 24 octets.
 
 
+/*********************** Key encapsulation mechanism API with compressed keys ***********************/
+
+#define CRYPTO_SECRETKEYBYTES_COMPRESSED     410    // MSG_BYTES + SECRETKEY_B_BYTES + CRYPTO_PUBLICKEYBYTES_COMPRESSED bytes
+#define CRYPTO_PUBLICKEYBYTES_COMPRESSED     330
+#define CRYPTO_CIPHERTEXTBYTES_COMPRESSED    412    // SIDH_PUBLICKEYBYTES_COMPRESSED_A + MSG_BYTES bytes
+
+// SIKE's key generation with a compressed public key
+// Outputs: secret key sk (CRYPTO_SECRETKEYBYTES_COMPRESSED = 410 bytes)
+//          public key pk (CRYPTO_PUBLICKEYBYTES_COMPRESSED = 330 bytes) 
+int crypto_kem_keypair_compressed(unsigned char *pk, unsigned char *sk);
+
+// SIKE's encapsulation with a compressed public key and ciphertext
+// Input:   public key pk         (CRYPTO_PUBLICKEYBYTES_COMPRESSED = 330 bytes)
+// Outputs: shared secret ss      (CRYPTO_BYTES = 24 bytes)
+//          ciphertext message ct (CRYPTO_CIPHERTEXTBYTES_COMPRESSED = 412 bytes)
+// Returns 1 if pk is malformed, 0 otherwise.
+int crypto_kem_enc_compressed(unsigned char *ct, unsigned char *ss, const unsigned char *pk);
+
+// SIKE's decapsulation with a compressed public key and ciphertext
+// Input:   secret key sk         (CRYPTO_SECRETKEYBYTES_COMPRESSED = 410 bytes)
+//          ciphertext message ct (CRYPTO_CIPHERTEXTBYTES_COMPRESSED = 412 bytes) 
+// Outputs: shared secret ss      (CRYPTO_BYTES = 24 bytes)
+int crypto_kem_dec_compressed(unsigned char *ss, const unsigned char *ct, const unsigned char *sk);
+
+// The compressed KEM is SIKE with pk and the public key in ct replaced by their compressed forms (see the 
+// public key compression API below), also as inputs of the hash functions. It does not interoperate with the 
+// KEM above. Public keys are about 40% and ciphertexts about 30% smaller, and every operation is slower, see README.md.
+
+
+/*********************** Resumable key encapsulation mechanism API ***********************/
+
+#define CRYPTO_OPBYTES    10048   // Size of the state of a resumable operation
+
+typedef struct {
+    unsigned long long state[CRYPTO_OPBYTES/8];
+} sike_op_t;
+
+// Start crypto_kem_keypair, crypto_kem_enc or crypto_kem_dec with the same arguments as a resumable operation in op.
+// The buffers must stay valid and the inputs unchanged until the operation is complete, the outputs are only valid then.
+void sike_op_init_keypair(sike_op_t *op, unsigned char *pk, unsigned char *sk);
+void sike_op_init_enc(sike_op_t *op, unsigned char *ct, unsigned char *ss, const unsigned char *pk);
+void sike_op_init_dec(sike_op_t *op, unsigned char *ss, const unsigned char *ct, const unsigned char *sk);
+
+// Runs up to budget steps of an operation. Returns 1 once the operation is complete and 0 otherwise.
+// A step is one bit of the 3-point ladder, one doubling by 4 or tripling of the tree traversal, one isogeny evaluation or one of
+// the parts around them, the longest of which has an inversion in GF(p^2). The number of steps only depends on the type of the operation.
+int sike_op_step(sike_op_t *op, const unsigned int budget);
+
+// Ends an operation and clears op. Returns 0 if the operation was complete, with the outputs of the KEM function, and -1 otherwise.
+int sike_op_done(sike_op_t *op);
+
+
 /*********************** Ephemeral key exchange API ***********************/
 
 #define SIDH_SECRETKEYBYTES      48
@@ -95,6 +147,36 @@ int EphemeralSecretAgreement_A(const unsigned char* PrivateKeyA, const unsigned
 int EphemeralSecretAgreement_B(const unsigned char* PrivateKeyB, const unsigned char* PublicKeyA, unsigned char* SharedSecretB);
 
 
+/*********************** Public key compression API ***********************/
+
+#define SIDH_PUBLICKEYBYTES_COMPRESSED_A    380
+#define SIDH_PUBLICKEYBYTES_COMPRESSED_B    330
+
+// Alice's public key compression
+// Input:  Alice's PublicKeyA, 3 GF(p751^2) elements encoded in 564 bytes.
+// Output: the compressed public key CompressedPKA encoded in 380 bytes.
+// Returns 1 in the negligible case that PublicKeyA has no compressed form, 0 otherwise.
+int PublicKeyCompression_A(const unsigned char* PublicKeyA, unsigned char* CompressedPKA);
+
+// Bob's public key compression
+// Input:  Bob's PublicKeyB, 3 GF(p751^2) elements encoded in 564 bytes.
+// Output: the compressed public key CompressedPKB encoded in 330 bytes.
+// Returns 1 in the negligible case that PublicKeyB has no compressed form, 0 otherwise.
+int PublicKeyCompression_B(const unsigned char* PublicKeyB, unsigned char* CompressedPKB);
+
+// Alice's public key decompression
+// Input:  Alice's CompressedPKA encoded in 380 bytes.
+// Output: Alice's public key PublicKeyA encoded in 564 bytes.
+// Returns 1 if CompressedPKA is malformed, 0 otherwise.
+int PublicKeyDecompression_A(const unsigned char* CompressedPKA, unsigned char* PublicKeyA);
+
+// Bob's public key decompression
+// Input:  Bob's CompressedPKB encoded in 330 bytes.
+// Output: a public key PublicKeyB encoded in 564 bytes, which gives the same shared secret as Bob's public key in EphemeralSecretAgreement_A.
+// Returns 1 if CompressedPKB is malformed, 0 otherwise.
+int PublicKeyDecompression_B(const unsigned char* CompressedPKB, unsigned char* PublicKeyB);
+
+
 // Encoding of keys for KEX-based isogeny system "SIDHp751" (wire format):
 // ----------------------------------------------------------------------
 // Elements over GF(p751) are encoded in 94 octets in little endian format (i.e., the least significant octet is located in the lowest memory address). 
@@ -104,6 +186,10 @@ int EphemeralSecretAgreement_B(const unsigned char* PrivateKeyB, const unsigned
 // in 48 octets in little endian format. 
 // Public keys PublicKeyA and PublicKeyB consist of 3 elements in GF(p751^2). In the SIDH API, they are encoded in 564 octets. 
 // Shared keys SharedSecretA and SharedSecretB consist of one element in GF(p751^2). In the SIDH API, they are encoded in 188 octets.
+// Compressed public keys consist of the coefficient A in GF(p751^2) and the coordinates of the points of the public key in a basis of E_A[3^239] 
+// for Alice and of E_A[2^372] for Bob, encoded in 48 and 47 octets in little endian format, resp. Alice's compressed keys hold the 4 coordinates of
+// P and Q, Bob's hold 3 coordinates divided by an invertible one and one byte. In the SIDH API, CompressedPKA and CompressedPKB are encoded in 
+// 188 + 4*48 = 380 and 188 + 3*47 + 1 = 330 octets, resp.
 
 
 #endif
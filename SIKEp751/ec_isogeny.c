@@ -180,16 +180,32 @@ void inv_3_way(f2elm_t z1, f2elm_t z2, f2elm_t z3)
 { // 3-way simultaneous inversion
   // Input:  z1,z2,z3
   // Output: 1/z1,1/z2,1/z3 (override inputs).
-    f2elm_t t0, t1, t2, t3;
+    f2elm_t z[3], zinv[3];
+
+    fp2copy(z1, z[0]);
+    fp2copy(z2, z[1]);
+    fp2copy(z3, z[2]);
+    mont_n_way_inv((const f2elm_t*)z, 3, zinv);
+    fp2copy(zinv[0], z1);
+    fp2copy(zinv[1], z2);
+    fp2copy(zinv[2], z3);
+}
+
 
-    fp2mul_mont(z1, z2, t0);                      // t0 = z1*z2
-    fp2mul_mont(z3, t0, t1);                      // t1 = z1*z2*z3
-    fp2inv_mont(t1);                              // t1 = 1/(z1*z2*z3)
-    fp2mul_mont(z3, t1, t2);                      // t2 = 1/(z1*z2) 
-    fp2mul_mont(t2, z2, t3);                      // t3 = 1/z1
-    fp2mul_mont(t2, z1, z2);                      // z2 = 1/z2
-    fp2mul_mont(t0, t1, z3);                      // z3 = 1/z3
-    fp2copy(t3, z1);                              // z1 = 1/z1
+void inv_3_way_bingcd(f2elm_t z1, f2elm_t z2, f2elm_t z3, const f2elm_t mask)
+{ // 3-way simultaneous inversion using the variable-time inversion on a masked product
+  // Input:  z1,z2,z3 and a nonzero mask that is unknown to the adversary
+  // Output: 1/z1,1/z2,1/z3 (override inputs).
+  // Only the product z1*z2*z3*mask reaches fp2inv_mont_bingcd, never the z_i themselves.
+    f2elm_t z[3], zinv[3];
+
+    fp2copy(z1, z[0]);
+    fp2copy(z2, z[1]);
+    fp2copy(z3, z[2]);
+    mont_n_way_inv_bingcd((const f2elm_t*)z, 3, zinv, mask);
+    fp2copy(zinv[0], z1);
+    fp2copy(zinv[1], z2);
+    fp2copy(zinv[2], z3);
 }
 
 
@@ -197,6 +213,7 @@ void get_A(const f2elm_t xP, const f2elm_t xQ, const f2elm_t xR, f2elm_t A)
 { // Given the x-coordinates of P, Q, and R, returns the value A corresponding to the Montgomery curve E_A: y^2=x^3+A*x^2+x such that R=Q-P on E_A.
   // Input:  the x-coordinates xP, xQ, and xR of the points P, Q and R.
   // Output: the coefficient A corresponding to the curve E_A: y^2=x^3+A*x^2+x.
+  // SECURITY NOTE: This function does not run in constant-time and must only be called on public values.
     f2elm_t t0, t1, one = {0};
     
     fpcopy((digit_t*)&Montgomery_one, one[0]);
@@ -210,34 +227,65 @@ void get_A(const f2elm_t xP, const f2elm_t xQ, const f2elm_t xR, f2elm_t A)
     fp2add(t1, xR, t1);                           // t1 = t1+xR
     fp2add(t0, t0, t0);                           // t0 = t0+t0
     fp2sqr_mont(A, A);                            // A = A^2
-    fp2inv_mont(t0);                              // t0 = 1/t0
+    fp2inv_mont_bingcd(t0);                       // t0 = 1/t0, variable-time as xP, xQ and xR are public
     fp2mul_mont(A, t0, A);                        // A = A*t0
     fp2sub(A, t1, A);                             // Afinal = A-t1
 }
 
+void get_A_proj(const f2elm_t xP, const f2elm_t xQ, const f2elm_t xR, f2elm_t A, f2elm_t C)
+{ // Projective version of get_A, (A:C) such that A/C is the coefficient returned by get_A. There is no inversion.
+  // Input:  the x-coordinates xP, xQ, and xR of the points P, Q and R.
+  // Output: A = (xP*xQ+xP*xR+xQ*xR-1)^2-4*xP*xQ*xR*(xP+xQ+xR) and C = 4*xP*xQ*xR.
+    f2elm_t t0, t1, one = {0};
+    
+    fpcopy((digit_t*)&Montgomery_one, one[0]);
+    fp2add(xP, xQ, t1);                           // t1 = xP+xQ
+    fp2mul_mont(xP, xQ, t0);                      // t0 = xP*xQ
+    fp2mul_mont(xR, t1, A);                       // A = xR*t1
+    fp2add(t0, A, A);                             // A = A+t0
+    fp2mul_mont(t0, xR, t0);                      // t0 = t0*xR
+    fp2sub(A, one, A);                            // A = A-1
+    fp2add(t0, t0, t0);                           // t0 = t0+t0
+    fp2add(t1, xR, t1);                           // t1 = t1+xR
+    fp2add(t0, t0, C);                            // C = 4*xP*xQ*xR
+    fp2sqr_mont(A, A);                            // A = A^2
+    fp2mul_mont(C, t1, t1);                       // t1 = C*(xP+xQ+xR)
+    fp2sub(A, t1, A);                             // Afinal = A-t1
+}
 
-void j_inv(const f2elm_t A, const f2elm_t C, f2elm_t jinv)
-{ // Computes the j-invariant of a Montgomery curve with projective constant.
+
+void j_inv_proj(const f2elm_t A, const f2elm_t C, f2elm_t jnum, f2elm_t jden)
+{ // Computes the j-invariant of a Montgomery curve with projective constant as a fraction, without inversion.
   // Input: A,C in GF(p^2).
-  // Output: j=256*(A^2-3*C^2)^3/(C^4*(A^2-4*C^2)), which is the j-invariant of the Montgomery curve B*y^2=x^3+(A/C)*x^2+x or (equivalently) j-invariant of B'*y^2=C*x^3+A*x^2+C*x.
-    f2elm_t t0, t1;
+  // Output: jnum=256*(A^2-3*C^2)^3 and jden=C^4*(A^2-4*C^2), j=jnum/jden. jden must not overlap C.
+    f2elm_t t1;
     
-    fp2sqr_mont(A, jinv);                           // jinv = A^2        
+    fp2sqr_mont(A, jden);                           // jden = A^2        
     fp2sqr_mont(C, t1);                             // t1 = C^2
-    fp2add(t1, t1, t0);                             // t0 = t1+t1
-    fp2sub(jinv, t0, t0);                           // t0 = jinv-t0
-    fp2sub(t0, t1, t0);                             // t0 = t0-t1
-    fp2sub(t0, t1, jinv);                           // jinv = t0-t1
+    fp2add(t1, t1, jnum);                           // jnum = t1+t1
+    fp2sub(jden, jnum, jnum);                       // jnum = jden-jnum
+    fp2sub(jnum, t1, jnum);                         // jnum = jnum-t1
+    fp2sub(jnum, t1, jden);                         // jden = jnum-t1
     fp2sqr_mont(t1, t1);                            // t1 = t1^2
-    fp2mul_mont(jinv, t1, jinv);                    // jinv = jinv*t1
-    fp2add(t0, t0, t0);                             // t0 = t0+t0
-    fp2add(t0, t0, t0);                             // t0 = t0+t0
-    fp2sqr_mont(t0, t1);                            // t1 = t0^2
-    fp2mul_mont(t0, t1, t0);                        // t0 = t0*t1
-    fp2add(t0, t0, t0);                             // t0 = t0+t0
-    fp2add(t0, t0, t0);                             // t0 = t0+t0
-    fp2inv_mont(jinv);                              // jinv = 1/jinv 
-    fp2mul_mont(jinv, t0, jinv);                    // jinv = t0*jinv
+    fp2mul_mont(jden, t1, jden);                    // jden = jden*t1
+    fp2add(jnum, jnum, jnum);                       // jnum = jnum+jnum
+    fp2add(jnum, jnum, jnum);                       // jnum = jnum+jnum
+    fp2sqr_mont(jnum, t1);                          // t1 = jnum^2
+    fp2mul_mont(jnum, t1, jnum);                    // jnum = jnum*t1
+    fp2add(jnum, jnum, jnum);                       // jnum = jnum+jnum
+    fp2add(jnum, jnum, jnum);                       // jnum = jnum+jnum
+}
+
+
+void j_inv(const f2elm_t A, const f2elm_t C, f2elm_t jinv)
+{ // Computes the j-invariant of a Montgomery curve with projective constant.
+  // Input: A,C in GF(p^2).
+  // Output: j=256*(A^2-3*C^2)^3/(C^4*(A^2-4*C^2)), which is the j-invariant of the Montgomery curve B*y^2=x^3+(A/C)*x^2+x or (equivalently) j-invariant of B'*y^2=C*x^3+A*x^2+C*x.
+    f2elm_t jden;
+
+    j_inv_proj(A, C, jinv, jden);
+    fp2inv_mont(jden);                              // jden = 1/jden
+    fp2mul_mont(jinv, jden, jinv);                  // jinv = jnum/jden
 }
 
 
@@ -292,44 +340,245 @@ static void swap_points(point_proj_t P, point_proj_t Q, const digit_t option)
 }
 
 
-static void LADDER3PT(const f2elm_t xP, const f2elm_t xQ, const f2elm_t xPQ, const digit_t* m, const unsigned int AliceOrBob, point_proj_t R, const f2elm_t A)
-{
-    point_proj_t R0 = {0}, R2 = {0};
-    f2elm_t A24 = {0};
-    digit_t mask;
-    int i, nbits, bit, swap, prevbit = 0;
+#if defined(_FIXED_BASE_)
+
+#define FIXED_BASE_BATCH    64              // Number of points normalized with one inversion when a table is computed
+
+static felm_t fixed_base_Alice[OALICE_BITS], fixed_base_Bob[OBOB_BITS];
+static unsigned int fixed_base_state[2];    // 0: not computed, 1: being computed, 2: ready
+
+
+static void fixed_base_table(const f2elm_t xQ, felm_t* table, const int nbits)
+{ // Computes the table of x([2^i]Q) for i = 0,...,nbits-1 on the starting curve (A = 0).
+  // x(Q) is in GF(p) and so are the x-coordinates of its multiples, so only their real parts are kept.
+    point_proj_t P = {0};
+    f2elm_t X[FIXED_BASE_BATCH], Z[FIXED_BASE_BATCH], invZ[FIXED_BASE_BATCH], A24plus = {0}, C24 = {0}, t;
+    int i, j, n;
+
+    fpcopy((digit_t*)&Montgomery_one, A24plus[0]);
+    fp2add(A24plus, A24plus, A24plus);              // A24plus = A+2C = 2
+    fp2add(A24plus, A24plus, C24);                  // C24 = 4C = 4
+    fp2copy(xQ, P->X);
+    fpcopy((digit_t*)&Montgomery_one, (digit_t*)P->Z);
+
+    for (i = 0; i < nbits; i += n) {
+        n = (nbits - i < FIXED_BASE_BATCH) ? nbits - i : FIXED_BASE_BATCH;
+        for (j = 0; j < n; j++) {
+            fp2copy(P->X, X[j]);
+            fp2copy(P->Z, Z[j]);
+            xDBL(P, P, A24plus, C24);
+        }
+        mont_n_way_inv((const f2elm_t*)Z, n, invZ);
+        for (j = 0; j < n; j++) {
+            fp2mul_mont(X[j], invZ[j], t);
+            fp2correction(t);
+            fpcopy(t[0], table[i+j]);
+        }
+    }
+}
+
+
+static void xADD_fixed(point_proj_t R2, const point_proj_t R, const felm_t x0)
+{ // Differential addition R2 <- R0+R2 of the ladder with precomputed tables, with R0 = (x0:1) read from the table and the difference R
+    f2elm_t t0, t1, t2;
+    felm_t xplus, xminus;
+
+    fpadd(x0, (digit_t*)&Montgomery_one, xplus);    // xplus = x0+1
+    fpsub(x0, (digit_t*)&Montgomery_one, xminus);   // xminus = x0-1
+    fpcorrection(xminus);
+    fp2add(R2->X, R2->Z, t0);                       // t0 = X2+Z2
+    fp2sub(R2->X, R2->Z, t1);                       // t1 = X2-Z2
+    fp2correction(t1);
+    fpmul_mont(xminus, t0[0], t2[0]);
+    fpmul_mont(xminus, t0[1], t2[1]);               // t2 = (x0-1)*(X2+Z2)
+    fpmul_mont(xplus, t1[0], t0[0]);
+    fpmul_mont(xplus, t1[1], t0[1]);                // t0 = (x0+1)*(X2-Z2)
+    fp2add(t2, t0, t1);                             // t1 = (x0-1)*(X2+Z2)+(x0+1)*(X2-Z2)
+    fp2sub(t2, t0, t2);                             // t2 = (x0-1)*(X2+Z2)-(x0+1)*(X2-Z2)
+    fp2sqr_mont(t1, t1);
+    fp2sqr_mont(t2, t2);
+    fp2mul_mont(R->Z, t1, R2->X);                   // X2 = ZR*[(x0-1)*(X2+Z2)+(x0+1)*(X2-Z2)]^2
+    fp2mul_mont(R->X, t2, R2->Z);                   // Z2 = XR*[(x0-1)*(X2+Z2)-(x0+1)*(X2-Z2)]^2
+}
+
+#endif
 
-    if (AliceOrBob == ALICE) {
-        nbits = OALICE_BITS;
-    } else {
-        nbits = OBOB_BITS;
+#if defined(_PROJECTIVE_A_)
+
+static void xDBLADD_proj(point_proj_t P, point_proj_t Q, const point_proj_t PQ, const f2elm_t A24plus, const f2elm_t C24)
+{ // Simultaneous doubling and differential addition on a curve with projective constants, for LADDER3PT_PROJ.
+  // Input: projective Montgomery points P=(XP:ZP), Q=(XQ:ZQ) and PQ=(XPQ:ZPQ) such that PQ = P-Q, and Montgomery curve constants A24plus = A+2C and C24 = 4C.
+  // Output: P <- 2*P and Q <- P+Q. Compared to xDBLADD, the doubling multiplies once more, by C24.
+    f2elm_t t0, t1, t2, t3;
+
+    fp2add(P->X, P->Z, t0);                         // t0 = XP+ZP
+    fp2sub(P->X, P->Z, t1);                         // t1 = XP-ZP
+    fp2add(Q->X, Q->Z, t2);                         // t2 = XQ+ZQ
+    fp2sub(Q->X, Q->Z, t3);                         // t3 = XQ-ZQ
+    fp2correction(t3);
+    fp2mul_mont(t1, t2, t2);                        // t2 = (XP-ZP)*(XQ+ZQ)
+    fp2mul_mont(t0, t3, t3);                        // t3 = (XP+ZP)*(XQ-ZQ)
+    fp2sqr_mont(t0, t0);                            // t0 = (XP+ZP)^2
+    fp2sqr_mont(t1, t1);                            // t1 = (XP-ZP)^2
+    fp2add(t2, t3, Q->X);                           // XQ = (XP-ZP)*(XQ+ZQ)+(XP+ZP)*(XQ-ZQ)
+    fp2sub(t2, t3, Q->Z);                           // ZQ = (XP-ZP)*(XQ+ZQ)-(XP+ZP)*(XQ-ZQ)
+    fp2sub(t0, t1, t2);                             // t2 = (XP+ZP)^2-(XP-ZP)^2
+    fp2sqr_mont(Q->X, Q->X);                        // XQ = [(XP-ZP)*(XQ+ZQ)+(XP+ZP)*(XQ-ZQ)]^2
+    fp2sqr_mont(Q->Z, Q->Z);                        // ZQ = [(XP-ZP)*(XQ+ZQ)-(XP+ZP)*(XQ-ZQ)]^2
+    fp2mul_mont(C24, t1, t1);                       // t1 = C24*(XP-ZP)^2
+    fp2mul_mont(A24plus, t2, t3);                   // t3 = A24plus*[(XP+ZP)^2-(XP-ZP)^2]
+    fp2add(t3, t1, t3);                             // t3 = A24plus*[(XP+ZP)^2-(XP-ZP)^2]+C24*(XP-ZP)^2
+    fp2mul_mont(t0, t1, P->X);                      // XP = C24*(XP+ZP)^2*(XP-ZP)^2
+    fp2mul_mont(t3, t2, P->Z);                      // ZP = [A24plus*[(XP+ZP)^2-(XP-ZP)^2]+C24*(XP-ZP)^2]*[(XP+ZP)^2-(XP-ZP)^2]
+    fp2mul_mont(PQ->Z, Q->X, Q->X);                 // XQ = ZPQ*[(XP-ZP)*(XQ+ZQ)+(XP+ZP)*(XQ-ZQ)]^2
+    fp2mul_mont(PQ->X, Q->Z, Q->Z);                 // ZQ = XPQ*[(XP-ZP)*(XQ+ZQ)-(XP+ZP)*(XQ-ZQ)]^2
+}
+
+#endif
+
+
+/********************************************************************************************
+* The 3-point ladders run one bit at a time on a ladder_t, so that the key operations of sidh.c
+* can be suspended between two bits. LADDER3PT_START, LADDER3PT_KEYGEN_START and
+* LADDER3PT_PROJ_START pick the engine selected by FIXED_BASE and PROJECTIVE_A,
+* ladder_step() runs one bit and ladder_run() the remaining ones.
+*********************************************************************************************/
+
+enum { LADDER_XDBLADD, LADDER_FIXED_BASE, LADDER_PROJ };
+
+typedef struct {
+    unsigned int engine;
+    unsigned int bit, nbits, prevbit;
+    const digit_t* m;
+    point_proj_t R0, R2, R;                 // R0 = [2^bit]Q, except for LADDER_FIXED_BASE, which reads it from table
+    f2elm_t A24;                            // (A+2)/4, or A24plus = A+2C for LADDER_PROJ
+    f2elm_t C24;                            // C24 = 4C for LADDER_PROJ
+    const felm_t* table;                    // For LADDER_FIXED_BASE
+} ladder_t;
+
+
+static void ladder_start(ladder_t* L, const unsigned int engine, const f2elm_t xP, const f2elm_t xQ, const f2elm_t xPQ, const digit_t* m, const unsigned int nbits)
+{ // Initial points (xQ:1), (xPQ:1) and (xP:1) of a ladder computing x(P+[m]Q), with m of nbits bits. xQ is not used by LADDER_FIXED_BASE
+    L->engine = engine;
+    L->bit = 0;
+    L->nbits = nbits;
+    L->prevbit = 0;
+    L->m = m;
+    fp2zero(L->R0->X);
+    fp2zero(L->R0->Z);
+    if (xQ != NULL) {
+        fp2copy(xQ, L->R0->X);
+        fpcopy((digit_t*)&Montgomery_one, (digit_t*)L->R0->Z);
+    }
+    fp2copy(xPQ, L->R2->X);
+    fp2zero(L->R2->Z);
+    fpcopy((digit_t*)&Montgomery_one, (digit_t*)L->R2->Z);
+    fp2copy(xP, L->R->X);
+    fp2zero(L->R->Z);
+    fpcopy((digit_t*)&Montgomery_one, (digit_t*)L->R->Z);
+}
+
+
+static void ladder_start_A(ladder_t* L, const unsigned int engine, const f2elm_t xP, const f2elm_t xQ, const f2elm_t xPQ, const digit_t* m, const unsigned int AliceOrBob, const f2elm_t A)
+{ // Ladder on the curve A with A24 = (A+2)/4, for LADDER_XDBLADD
+    ladder_start(L, engine, xP, xQ, xPQ, m, (AliceOrBob == ALICE) ? OALICE_BITS : OBOB_BITS);
+    fp2zero(L->A24);
+    fpcopy((digit_t*)&Montgomery_one, L->A24[0]);
+    fp2add(L->A24, L->A24, L->A24);
+    fp2add(A, L->A24, L->A24);
+    fp2div2(L->A24, L->A24);  
+    fp2div2(L->A24, L->A24);                        // A24 = (A+2)/4
+}
+
+
+static int ladder_step(ladder_t* L)
+{ // Runs one bit of a ladder. Returns 1 once the ladder is complete, with x(P+[m]Q) in L->R
+    digit_t mask;
+    unsigned int bit;
+
+    bit = (unsigned int)(L->m[L->bit >> LOG2RADIX] >> (L->bit & (RADIX-1))) & 1;
+    mask = 0 - (digit_t)(bit ^ L->prevbit);
+    L->prevbit = bit;
+    swap_points(L->R, L->R2, mask);
+
+    switch (L->engine) {
+#if defined(_FIXED_BASE_)
+    case LADDER_FIXED_BASE:
+        xADD_fixed(L->R2, L->R, L->table[L->bit]);
+        break;
+#endif
+#if defined(_PROJECTIVE_A_)
+    case LADDER_PROJ:
+        xDBLADD_proj(L->R0, L->R2, L->R, L->A24, L->C24);
+        break;
+#endif
+    default:
+        xDBLADD(L->R0, L->R2, L->R->X, L->A24);
+        fp2mul_mont(L->R2->X, L->R->Z, L->R2->X);
+        break;
     }
 
-    // Initializing constant
-    fpcopy((digit_t*)&Montgomery_one, A24[0]);
-    fp2add(A24, A24, A24);
-    fp2add(A, A24, A24);
-    fp2div2(A24, A24);  
-    fp2div2(A24, A24); // A24 = (A+2)/4
-
-    // Initializing points
-    fp2copy(xQ, R0->X);
-    fpcopy((digit_t*)&Montgomery_one, (digit_t*)R0->Z);
-    fp2copy(xPQ, R2->X);
-    fpcopy((digit_t*)&Montgomery_one, (digit_t*)R2->Z);
-    fp2copy(xP, R->X);
-    fpcopy((digit_t*)&Montgomery_one, (digit_t*)R->Z);
-    fpzero((digit_t*)(R->Z)[1]);
-
-    // Main loop
-    for (i = 0; i < nbits; i++) {
-        bit = (m[i >> LOG2RADIX] >> (i & (RADIX-1))) & 1;
-        swap = bit ^ prevbit;
-        prevbit = bit;
-        mask = 0 - (digit_t)swap;
-
-        swap_points(R, R2, mask);
-        xDBLADD(R0, R2, R->X, A24);
-        fp2mul_mont(R2->X, R->Z, R2->X);
+    if (++L->bit < L->nbits) return 0;
+    mask = 0 - (digit_t)L->prevbit;                 // Undo the swap of the last bit, for m with bit nbits-1 set
+    swap_points(L->R, L->R2, mask);
+    return 1;
+}
+
+
+static void ladder_run(ladder_t* L, point_proj_t R)
+{ // Runs the remaining bits of a ladder, R = x(P+[m]Q)
+    while (ladder_step(L) == 0);
+    fp2copy(L->R->X, R->X);
+    fp2copy(L->R->Z, R->Z);
+}
+
+
+static void LADDER3PT_START(ladder_t* L, const f2elm_t xP, const f2elm_t xQ, const f2elm_t xPQ, const digit_t* m, const unsigned int AliceOrBob, const f2elm_t A)
+{ // Starts LADDER3PT
+    ladder_start_A(L, LADDER_XDBLADD, xP, xQ, xPQ, m, AliceOrBob, A);
+}
+
+
+static void LADDER3PT(const f2elm_t xP, const f2elm_t xQ, const f2elm_t xPQ, const digit_t* m, const unsigned int AliceOrBob, point_proj_t R, const f2elm_t A)
+{ // Right-to-left 3-point ladder computing x(P+[m]Q)
+    ladder_t L;
+
+    LADDER3PT_START(&L, xP, xQ, xPQ, m, AliceOrBob, A);
+    ladder_run(&L, R);
+}
+
+
+static void LADDER3PT_KEYGEN_START(ladder_t* L, const f2elm_t xP, const f2elm_t xQ, const f2elm_t xPQ, const digit_t* m, const unsigned int AliceOrBob, const f2elm_t A)
+{ // Starts LADDER3PT on the public basis of key generation, where A = 0.
+  // With _FIXED_BASE_, the first key generation of each party computes the table of x([2^i]Q) and all later ones read it in the ladder.
+  // Threads that find the table being computed by another one run LADDER3PT.
+#if defined(_FIXED_BASE_)
+    unsigned int k = (AliceOrBob == ALICE) ? 0 : 1, state;
+    felm_t* table = (AliceOrBob == ALICE) ? fixed_base_Alice : fixed_base_Bob;
+    int nbits = (AliceOrBob == ALICE) ? OALICE_BITS : OBOB_BITS;
+
+    state = __atomic_load_n(&fixed_base_state[k], __ATOMIC_ACQUIRE);
+    if (state == 0 && __atomic_compare_exchange_n(&fixed_base_state[k], &state, 1, 0, __ATOMIC_ACQUIRE, __ATOMIC_ACQUIRE)) {
+        fixed_base_table(xQ, table, nbits);
+        state = 2;
+        __atomic_store_n(&fixed_base_state[k], state, __ATOMIC_RELEASE);
+    }
+    if (state == 2) {
+        ladder_start(L, LADDER_FIXED_BASE, xP, NULL, xPQ, m, (unsigned int)nbits);
+        L->table = (const felm_t*)table;
+        return;
     }
-}
\ No newline at end of file
+#endif
+    LADDER3PT_START(L, xP, xQ, xPQ, m, AliceOrBob, A);
+}
+
+#if defined(_PROJECTIVE_A_)
+
+static void LADDER3PT_PROJ_START(ladder_t* L, const f2elm_t xP, const f2elm_t xQ, const f2elm_t xPQ, const digit_t* m, const unsigned int AliceOrBob, const f2elm_t A24plus, const f2elm_t C24)
+{ // Starts LADDER3PT on the curve with projective constants A24plus = A+2C and C24 = 4C, e.g., from get_A_proj, so that A/C is not needed
+    ladder_start(L, LADDER_PROJ, xP, xQ, xPQ, m, (AliceOrBob == ALICE) ? OALICE_BITS : OBOB_BITS);
+    fp2copy(A24plus, L->A24);
+    fp2copy(C24, L->C24);
+}
+
+#endif
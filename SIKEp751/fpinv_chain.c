@@ -0,0 +1,197 @@
+/********************************************************************************************
+* Supersingular Isogeny Key Encapsulation Library
+*
+* Abstract: addition chain for the field inversion in GF(p751), p751 = 2^372*3^239-1
+*           Generated by tools/gen_chain.c, do not edit.
+*
+* Chain for (p751-3)/4: 760 squarings and 99 multiplications.
+* Sliding window only: 744 squarings and 147 multiplications.
+*********************************************************************************************/
+
+
+void fpinv_chain_mont(felm_t a)
+{ // Chain to compute a^(p751-3)/4 using Montgomery arithmetic
+    felm_t tt, t[15], u[2];
+    unsigned int i;
+
+    // Precomputed table a^3, a^5, ..., a^31
+    fpsqr_mont(a, tt);
+    fpmul_mont(a, tt, t[0]);
+    for (i = 0; i < 14; i++) fpmul_mont(t[i], tt, t[i+1]);
+
+    // Powers a^(2^k-1) for k = 10, 20
+    fpcopy(t[14], u[0]);
+    for (i = 0; i < 5; i++) fpsqr_mont(u[0], u[0]);
+    fpmul_mont(t[14], u[0], u[0]);
+    fpcopy(u[0], u[1]);
+    for (i = 0; i < 10; i++) fpsqr_mont(u[1], u[1]);
+    fpmul_mont(u[0], u[1], u[1]);
+
+    // Windows from the most significant bit
+    fpcopy(t[12], tt);
+    for (i = 0; i < 5; i++) fpsqr_mont(tt, tt);
+    fpmul_mont(t[14], tt, tt);
+    for (i = 0; i < 7; i++) fpsqr_mont(tt, tt);
+    fpmul_mont(t[10], tt, tt);
+    for (i = 0; i < 6; i++) fpsqr_mont(tt, tt);
+    fpmul_mont(t[9], tt, tt);
+    for (i = 0; i < 2; i++) fpsqr_mont(tt, tt);
+    fpmul_mont(a, tt, tt);
+    for (i = 0; i < 10; i++) fpsqr_mont(tt, tt);
+    fpmul_mont(t[14], tt, tt);
+    for (i = 0; i < 4; i++) fpsqr_mont(tt, tt);
+    fpmul_mont(t[2], tt, tt);
+    for (i = 0; i < 6; i++) fpsqr_mont(tt, tt);
+    fpmul_mont(t[2], tt, tt);
+    for (i = 0; i < 9; i++) fpsqr_mont(tt, tt);
+    fpmul_mont(t[2], tt, tt);
+    for (i = 0; i < 8; i++) fpsqr_mont(tt, tt);
+    fpmul_mont(t[3], tt, tt);
+    for (i = 0; i < 5; i++) fpsqr_mont(tt, tt);
+    fpmul_mont(t[3], tt, tt);
+    for (i = 0; i < 9; i++) fpsqr_mont(tt, tt);
+    fpmul_mont(t[8], tt, tt);
+    for (i = 0; i < 4; i++) fpsqr_mont(tt, tt);
+    fpmul_mont(t[6], tt, tt);
+    for (i = 0; i < 7; i++) fpsqr_mont(tt, tt);
+    fpmul_mont(t[10], tt, tt);
+    for (i = 0; i < 5; i++) fpsqr_mont(tt, tt);
+    fpmul_mont(t[10], tt, tt);
+    for (i = 0; i < 5; i++) fpsqr_mont(tt, tt);
+    fpmul_mont(t[4], tt, tt);
+    for (i = 0; i < 4; i++) fpsqr_mont(tt, tt);
+    fpmul_mont(t[2], tt, tt);
+    for (i = 0; i < 8; i++) fpsqr_mont(tt, tt);
+    fpmul_mont(t[11], tt, tt);
+    for (i = 0; i < 3; i++) fpsqr_mont(tt, tt);
+    fpmul_mont(t[1], tt, tt);
+    for (i = 0; i < 9; i++) fpsqr_mont(tt, tt);
+    fpmul_mont(t[9], tt, tt);
+    for (i = 0; i < 5; i++) fpsqr_mont(tt, tt);
+    fpmul_mont(t[7], tt, tt);
+    for (i = 0; i < 5; i++) fpsqr_mont(tt, tt);
+    fpmul_mont(t[4], tt, tt);
+    for (i = 0; i < 4; i++) fpsqr_mont(tt, tt);
+    fpmul_mont(t[1], tt, tt);
+    for (i = 0; i < 10; i++) fpsqr_mont(tt, tt);
+    fpmul_mont(t[7], tt, tt);
+    for (i = 0; i < 4; i++) fpsqr_mont(tt, tt);
+    fpmul_mont(t[2], tt, tt);
+    for (i = 0; i < 6; i++) fpsqr_mont(tt, tt);
+    fpmul_mont(t[4], tt, tt);
+    for (i = 0; i < 6; i++) fpsqr_mont(tt, tt);
+    fpmul_mont(t[3], tt, tt);
+    for (i = 0; i < 6; i++) fpsqr_mont(tt, tt);
+    fpmul_mont(t[10], tt, tt);
+    for (i = 0; i < 5; i++) fpsqr_mont(tt, tt);
+    fpmul_mont(t[3], tt, tt);
+    for (i = 0; i < 8; i++) fpsqr_mont(tt, tt);
+    fpmul_mont(a, tt, tt);
+    for (i = 0; i < 9; i++) fpsqr_mont(tt, tt);
+    fpmul_mont(t[8], tt, tt);
+    for (i = 0; i < 3; i++) fpsqr_mont(tt, tt);
+    fpmul_mont(t[1], tt, tt);
+    for (i = 0; i < 4; i++) fpsqr_mont(tt, tt);
+    fpmul_mont(t[0], tt, tt);
+    for (i = 0; i < 9; i++) fpsqr_mont(tt, tt);
+    fpmul_mont(t[11], tt, tt);
+    for (i = 0; i < 4; i++) fpsqr_mont(tt, tt);
+    fpmul_mont(t[6], tt, tt);
+    for (i = 0; i < 5; i++) fpsqr_mont(tt, tt);
+    fpmul_mont(t[4], tt, tt);
+    for (i = 0; i < 6; i++) fpsqr_mont(tt, tt);
+    fpmul_mont(t[13], tt, tt);
+    for (i = 0; i < 6; i++) fpsqr_mont(tt, tt);
+    fpmul_mont(t[14], tt, tt);
+    for (i = 0; i < 2; i++) fpsqr_mont(tt, tt);
+    fpmul_mont(a, tt, tt);
+    for (i = 0; i < 9; i++) fpsqr_mont(tt, tt);
+    fpmul_mont(t[13], tt, tt);
+    for (i = 0; i < 4; i++) fpsqr_mont(tt, tt);
+    fpmul_mont(t[4], tt, tt);
+    for (i = 0; i < 5; i++) fpsqr_mont(tt, tt);
+    fpmul_mont(t[5], tt, tt);
+    for (i = 0; i < 5; i++) fpsqr_mont(tt, tt);
+    fpmul_mont(t[3], tt, tt);
+    for (i = 0; i < 5; i++) fpsqr_mont(tt, tt);
+    fpmul_mont(t[4], tt, tt);
+    for (i = 0; i < 7; i++) fpsqr_mont(tt, tt);
+    fpmul_mont(t[12], tt, tt);
+    for (i = 0; i < 7; i++) fpsqr_mont(tt, tt);
+    fpmul_mont(t[5], tt, tt);
+    for (i = 0; i < 9; i++) fpsqr_mont(tt, tt);
+    fpmul_mont(t[8], tt, tt);
+    for (i = 0; i < 4; i++) fpsqr_mont(tt, tt);
+    fpmul_mont(t[6], tt, tt);
+    for (i = 0; i < 6; i++) fpsqr_mont(tt, tt);
+    fpmul_mont(t[14], tt, tt);
+    for (i = 0; i < 4; i++) fpsqr_mont(tt, tt);
+    fpmul_mont(t[0], tt, tt);
+    for (i = 0; i < 8; i++) fpsqr_mont(tt, tt);
+    fpmul_mont(t[13], tt, tt);
+    for (i = 0; i < 5; i++) fpsqr_mont(tt, tt);
+    fpmul_mont(t[10], tt, tt);
+    for (i = 0; i < 8; i++) fpsqr_mont(tt, tt);
+    fpmul_mont(t[14], tt, tt);
+    for (i = 0; i < 6; i++) fpsqr_mont(tt, tt);
+    fpmul_mont(t[11], tt, tt);
+    for (i = 0; i < 6; i++) fpsqr_mont(tt, tt);
+    fpmul_mont(t[4], tt, tt);
+    for (i = 0; i < 2; i++) fpsqr_mont(tt, tt);
+    fpmul_mont(a, tt, tt);
+    for (i = 0; i < 9; i++) fpsqr_mont(tt, tt);
+    fpmul_mont(t[9], tt, tt);
+    for (i = 0; i < 7; i++) fpsqr_mont(tt, tt);
+    fpmul_mont(t[8], tt, tt);
+    for (i = 0; i < 4; i++) fpsqr_mont(tt, tt);
+    fpmul_mont(t[6], tt, tt);
+    for (i = 0; i < 8; i++) fpsqr_mont(tt, tt);
+    fpmul_mont(t[6], tt, tt);
+    for (i = 0; i < 8; i++) fpsqr_mont(tt, tt);
+    fpmul_mont(t[9], tt, tt);
+    for (i = 0; i < 8; i++) fpsqr_mont(tt, tt);
+    fpmul_mont(t[13], tt, tt);
+    for (i = 0; i < 4; i++) fpsqr_mont(tt, tt);
+    fpmul_mont(t[5], tt, tt);
+    for (i = 0; i < 2; i++) fpsqr_mont(tt, tt);
+    fpmul_mont(a, tt, tt);
+    for (i = 0; i < 11; i++) fpsqr_mont(tt, tt);
+    fpmul_mont(u[0], tt, tt);
+    for (i = 0; i < 20; i++) fpsqr_mont(tt, tt);
+    fpmul_mont(u[1], tt, tt);
+    for (i = 0; i < 20; i++) fpsqr_mont(tt, tt);
+    fpmul_mont(u[1], tt, tt);
+    for (i = 0; i < 20; i++) fpsqr_mont(tt, tt);
+    fpmul_mont(u[1], tt, tt);
+    for (i = 0; i < 20; i++) fpsqr_mont(tt, tt);
+    fpmul_mont(u[1], tt, tt);
+    for (i = 0; i < 20; i++) fpsqr_mont(tt, tt);
+    fpmul_mont(u[1], tt, tt);
+    for (i = 0; i < 20; i++) fpsqr_mont(tt, tt);
+    fpmul_mont(u[1], tt, tt);
+    for (i = 0; i < 20; i++) fpsqr_mont(tt, tt);
+    fpmul_mont(u[1], tt, tt);
+    for (i = 0; i < 20; i++) fpsqr_mont(tt, tt);
+    fpmul_mont(u[1], tt, tt);
+    for (i = 0; i < 20; i++) fpsqr_mont(tt, tt);
+    fpmul_mont(u[1], tt, tt);
+    for (i = 0; i < 20; i++) fpsqr_mont(tt, tt);
+    fpmul_mont(u[1], tt, tt);
+    for (i = 0; i < 20; i++) fpsqr_mont(tt, tt);
+    fpmul_mont(u[1], tt, tt);
+    for (i = 0; i < 20; i++) fpsqr_mont(tt, tt);
+    fpmul_mont(u[1], tt, tt);
+    for (i = 0; i < 20; i++) fpsqr_mont(tt, tt);
+    fpmul_mont(u[1], tt, tt);
+    for (i = 0; i < 20; i++) fpsqr_mont(tt, tt);
+    fpmul_mont(u[1], tt, tt);
+    for (i = 0; i < 20; i++) fpsqr_mont(tt, tt);
+    fpmul_mont(u[1], tt, tt);
+    for (i = 0; i < 20; i++) fpsqr_mont(tt, tt);
+    fpmul_mont(u[1], tt, tt);
+    for (i = 0; i < 20; i++) fpsqr_mont(tt, tt);
+    fpmul_mont(u[1], tt, tt);
+    for (i = 0; i < 20; i++) fpsqr_mont(tt, tt);
+    fpmul_mont(u[1], tt, tt);
+    fpcopy(tt, a);
+}
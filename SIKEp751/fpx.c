@@ -68,13 +68,185 @@ void fpsqr_mont(const felm_t ma, felm_t mc)
 { // Multiprecision squaring, c = a^2 mod p.
     dfelm_t temp = {0};
 
-    mp_mul(ma, ma, temp, NWORDS_FIELD);
+    mp_sqr(ma, temp, NWORDS_FIELD);
     rdc_mont(temp, mc);
 }
 
 
+// Constant-time inversion by safegcd (Bernstein-Yang divsteps).
+// Values are kept in signed 62-bit limbs: limb i holds bits [62*i, 62*i+61], the top limb carries the sign.
+#define SAFEGCD_LIMBS         ((NBITS_FIELD + 63) / 62)
+#define SAFEGCD_ITERATIONS    (((49*NBITS_FIELD + 80) / 17 + 61) / 62)    // Divstep bound for NBITS_FIELD-bit inputs, in batches of 62
+#define SAFEGCD_M62           (((uint64_t)1 << 62) - 1)
+
+static void safegcd_to_s62(const digit_t* a, int64_t* r)
+{ // Conversion from NWORDS_FIELD 64-bit words to signed 62-bit limbs, a in [0, 2^(64*NWORDS_FIELD)-1].
+    unsigned int i, w, s;
+    uint64_t x;
+
+    for (i = 0; i < SAFEGCD_LIMBS; i++) {
+        w = (62*i) / 64;
+        s = (62*i) % 64;
+        x = (w < NWORDS_FIELD) ? ((uint64_t)a[w] >> s) : 0;
+        if (s > 2 && w + 1 < NWORDS_FIELD) {
+            x |= (uint64_t)a[w+1] << (64 - s);
+        }
+        r[i] = (int64_t)(x & SAFEGCD_M62);
+    }
+}
+
+
+static void safegcd_from_s62(const int64_t* r, digit_t* a)
+{ // Conversion from normalized signed 62-bit limbs in [0, p-1] to NWORDS_FIELD 64-bit words.
+    unsigned int j, i, s;
+    uint64_t x;
+
+    for (j = 0; j < NWORDS_FIELD; j++) {
+        i = (64*j) / 62;
+        s = (64*j) % 62;                                 // Always even, so two limbs cover the word
+        x = (uint64_t)r[i] >> s;
+        if (i + 1 < SAFEGCD_LIMBS) {
+            x |= (uint64_t)r[i+1] << (62 - s);
+        }
+        a[j] = (digit_t)x;
+    }
+}
+
+
+static int64_t safegcd_divsteps_62(int64_t delta, uint64_t f, uint64_t g, int64_t* t)
+{ // 62 divsteps on the low limbs of f and g, in constant time. 
+  // Output: the transition matrix t = [u, v, q, r] scaled by 2^62, such that 2^62*(f', g') = (u*f + v*g, q*f + r*g). Returns the new delta.
+    uint64_t u = 1, v = 0, q = 0, r = 1, c, x;
+    unsigned int i;
+
+    for (i = 0; i < 62; i++) {
+        c = (uint64_t)((0 - delta) >> 63) & (0 - (g & 1));       // c = 0xFF..F if delta > 0 and g is odd, else c = 0
+        x = (f ^ g) & c; f ^= x; g ^= x; g = (g ^ c) - c;         // (f, g) = (g, -f) if c
+        x = (u ^ q) & c; u ^= x; q ^= x; q = (q ^ c) - c;
+        x = (v ^ r) & c; v ^= x; r ^= x; r = (r ^ c) - c;
+        delta = (delta ^ (int64_t)c) - (int64_t)c;                // delta = -delta if c
+        c = 0 - (g & 1);                                          // g = (g+f)/2 if g is odd, else g = g/2
+        g += f & c; q += u & c; r += v & c;
+        g >>= 1; u <<= 1; v <<= 1;
+        delta++;
+    }
+    t[0] = (int64_t)u; t[1] = (int64_t)v; t[2] = (int64_t)q; t[3] = (int64_t)r;
+    return delta;
+}
+
+
+static void safegcd_update_fg(int64_t* f, int64_t* g, const int64_t* t)
+{ // (f, g) = t*(f, g)/2^62. The division is exact.
+    const int64_t u = t[0], v = t[1], q = t[2], r = t[3];
+    int128_t cf, cg;
+    unsigned int i;
+
+    cf = (int128_t)u*f[0] + (int128_t)v*g[0];
+    cg = (int128_t)q*f[0] + (int128_t)r*g[0];
+    cf >>= 62; cg >>= 62;
+    for (i = 1; i < SAFEGCD_LIMBS; i++) {
+        cf += (int128_t)u*f[i] + (int128_t)v*g[i];
+        cg += (int128_t)q*f[i] + (int128_t)r*g[i];
+        f[i-1] = (int64_t)cf & SAFEGCD_M62; cf >>= 62;
+        g[i-1] = (int64_t)cg & SAFEGCD_M62; cg >>= 62;
+    }
+    f[SAFEGCD_LIMBS-1] = (int64_t)cf;
+    g[SAFEGCD_LIMBS-1] = (int64_t)cg;
+}
+
+
+static void safegcd_update_de(int64_t* d, int64_t* e, const int64_t* t, const int64_t* p, const uint64_t pinv62)
+{ // (d, e) = t*(d, e)/2^62 mod p. Multiples of p are added to make the division exact.
+  // Inputs and outputs are in (-2*p, p), pinv62 = p^(-1) mod 2^62.
+    const int64_t u = t[0], v = t[1], q = t[2], r = t[3];
+    int64_t sd, se, md, me;
+    int128_t cd, ce;
+    unsigned int i;
+
+    sd = d[SAFEGCD_LIMBS-1] >> 63;                               // sd = -1 if d < 0
+    se = e[SAFEGCD_LIMBS-1] >> 63;
+    md = (u & sd) + (v & se);                                    // Offsets that keep the outputs above -2*p
+    me = (q & sd) + (r & se);
+    cd = (int128_t)u*d[0] + (int128_t)v*e[0];
+    ce = (int128_t)q*d[0] + (int128_t)r*e[0];
+    md -= (int64_t)((pinv62*(uint64_t)cd + (uint64_t)md) & SAFEGCD_M62);    // cd + md*p = 0 mod 2^62
+    me -= (int64_t)((pinv62*(uint64_t)ce + (uint64_t)me) & SAFEGCD_M62);
+    cd += (int128_t)p[0]*md;
+    ce += (int128_t)p[0]*me;
+    cd >>= 62; ce >>= 62;
+    for (i = 1; i < SAFEGCD_LIMBS; i++) {
+        cd += (int128_t)u*d[i] + (int128_t)v*e[i] + (int128_t)p[i]*md;
+        ce += (int128_t)q*d[i] + (int128_t)r*e[i] + (int128_t)p[i]*me;
+        d[i-1] = (int64_t)cd & SAFEGCD_M62; cd >>= 62;
+        e[i-1] = (int64_t)ce & SAFEGCD_M62; ce >>= 62;
+    }
+    d[SAFEGCD_LIMBS-1] = (int64_t)cd;
+    e[SAFEGCD_LIMBS-1] = (int64_t)ce;
+}
+
+
+static void safegcd_normalize(int64_t* d, const int64_t sign, const int64_t* p)
+{ // d = -d if sign < 0, followed by reduction to [0, p-1]. Input: d in (-2*p, p).
+    int64_t mask;
+    unsigned int i;
+
+    mask = d[SAFEGCD_LIMBS-1] >> 63;                             // d = d+p if d < 0
+    for (i = 0; i < SAFEGCD_LIMBS; i++) {
+        d[i] += p[i] & mask;
+    }
+    mask = sign >> 63;                                           // d = -d if sign < 0
+    for (i = 0; i < SAFEGCD_LIMBS; i++) {
+        d[i] = (d[i] ^ mask) - mask;
+    }
+    for (i = 0; i < SAFEGCD_LIMBS-1; i++) {
+        d[i+1] += d[i] >> 62; d[i] &= SAFEGCD_M62;
+    }
+    mask = d[SAFEGCD_LIMBS-1] >> 63;                             // d = d+p if d < 0
+    for (i = 0; i < SAFEGCD_LIMBS; i++) {
+        d[i] += p[i] & mask;
+    }
+    for (i = 0; i < SAFEGCD_LIMBS-1; i++) {
+        d[i+1] += d[i] >> 62; d[i] &= SAFEGCD_M62;
+    }
+}
+
+
+void fpinv_mont_safegcd(felm_t a)
+{ // Constant-time field inversion by safegcd, a = a^(-1)*R mod p. 
+  // Input: a in [0, 2*p-1]. Output: a in [0, p-1], 0 is mapped to 0. 
+    int64_t f[SAFEGCD_LIMBS], g[SAFEGCD_LIMBS], d[SAFEGCD_LIMBS] = {0}, e[SAFEGCD_LIMBS] = {0}, p[SAFEGCD_LIMBS], t[4];
+    int64_t delta = 1;
+    uint64_t pinv62;
+    unsigned int i;
+
+    fpcorrection(a);
+    safegcd_to_s62((digit_t*)PRIME, p);
+    safegcd_to_s62((digit_t*)PRIME, f);
+    safegcd_to_s62(a, g);
+    e[0] = 1;                                                    // Invariants: f = d*a and g = e*a mod p
+    pinv62 = (uint64_t)p[0];                                     // p^(-1) mod 2^62 by Newton iteration, 3 -> 6 -> 12 -> 24 -> 48 -> 96 bits
+    for (i = 0; i < 5; i++) {
+        pinv62 *= 2 - (uint64_t)p[0]*pinv62;
+    }
+
+    for (i = 0; i < SAFEGCD_ITERATIONS; i++) {
+        delta = safegcd_divsteps_62(delta, (uint64_t)f[0], (uint64_t)g[0], t);
+        safegcd_update_de(d, e, t, p, pinv62);
+        safegcd_update_fg(f, g, t);
+    }
+    // Now g = 0 and f = +-1, so +-d = (a*R)^(-1) = a^(-1)*R^(-1). Two multiplications by R^2 give a^(-1)*R
+    safegcd_normalize(d, f[SAFEGCD_LIMBS-1], p);
+    safegcd_from_s62(d, a);
+    fpmul_mont(a, (digit_t*)&Montgomery_R2, a);
+    fpmul_mont(a, (digit_t*)&Montgomery_R2, a);
+}
+
+
 void fpinv_mont(felm_t a)
 { // Field inversion using Montgomery arithmetic, a = a^(-1)*R mod p.
+#if defined(_SAFEGCD_INV_)
+    fpinv_mont_safegcd(a);
+#else
     felm_t tt;
 
     fpcopy(a, tt);
@@ -82,6 +254,7 @@ void fpinv_mont(felm_t a)
     fpsqr_mont(tt, tt);
     fpsqr_mont(tt, tt);
     fpmul_mont(a, tt, a);
+#endif
 }
 
 
@@ -136,15 +309,21 @@ void fp2correction(f2elm_t a)
 
 __inline static void mp_addfast(const digit_t* a, const digit_t* b, digit_t* c)
 { // Multiprecision addition, c = a+b.
-    
+#if defined(GENERIC_IMPLEMENTATION)
+    mp_add(a, b, c, NWORDS_FIELD);
+#else
     mp_add_asm(a, b, c); 
+#endif
 }
 
 
 __inline static void mp_addfastx2(const digit_t* a, const digit_t* b, digit_t* c)
 { // Double-length multiprecision addition, c = a+b. 
-    
+#if defined(GENERIC_IMPLEMENTATION)
+    mp_add(a, b, c, 2*NWORDS_FIELD);
+#else
     mp_addx2_asm(a, b, c); 
+#endif
 }
 
 
@@ -177,8 +356,11 @@ __inline unsigned int mp_sub(const digit_t* a, const digit_t* b, digit_t* c, con
 __inline static digit_t mp_subfast(const digit_t* a, const digit_t* b, digit_t* c)
 { // Multiprecision subtraction, c = a-b, where lng(a) = lng(b) = 2*NWORDS_FIELD. 
   // If c < 0 then returns mask = 0xFF..F, else mask = 0x00..0 
-
+#if defined(GENERIC_IMPLEMENTATION)
+    return (0 - (digit_t)mp_sub(a, b, c, 2*NWORDS_FIELD));
+#else
 	return mp_subx2_asm(a, b, c);
+#endif
 }
 
 
@@ -207,143 +389,7 @@ void fp2mul_mont(const f2elm_t a, const f2elm_t b, f2elm_t c)
 }
 
 
-void fpinv_chain_mont(felm_t a)
-{ // Chain to compute a^(p-3)/4 using Montgomery arithmetic.
-    unsigned int i, j;
-    felm_t t[27], tt;
-    
-    // Precomputed table
-    fpsqr_mont(a, tt);
-    fpmul_mont(a, tt, t[0]);
-    fpmul_mont(t[0], tt, t[1]);
-    fpmul_mont(t[1], tt, t[2]);
-    fpmul_mont(t[2], tt, t[3]); 
-    fpmul_mont(t[3], tt, t[3]);
-    for (i = 3; i <= 8; i++) fpmul_mont(t[i], tt, t[i+1]);
-    fpmul_mont(t[9], tt, t[9]);
-    for (i = 9; i <= 20; i++) fpmul_mont(t[i], tt, t[i+1]);
-    fpmul_mont(t[21], tt, t[21]); 
-    for (i = 21; i <= 24; i++) fpmul_mont(t[i], tt, t[i+1]); 
-    fpmul_mont(t[25], tt, t[25]);
-    fpmul_mont(t[25], tt, t[26]);
-
-    fpcopy(a, tt);
-    for (i = 0; i < 6; i++) fpsqr_mont(tt, tt);
-    fpmul_mont(t[20], tt, tt);
-    for (i = 0; i < 6; i++) fpsqr_mont(tt, tt);
-    fpmul_mont(t[24], tt, tt);
-    for (i = 0; i < 6; i++) fpsqr_mont(tt, tt);
-    fpmul_mont(t[11], tt, tt);
-    for (i = 0; i < 6; i++) fpsqr_mont(tt, tt);
-    fpmul_mont(t[8], tt, tt);
-    for (i = 0; i < 8; i++) fpsqr_mont(tt, tt);
-    fpmul_mont(t[2], tt, tt);
-    for (i = 0; i < 6; i++) fpsqr_mont(tt, tt);
-    fpmul_mont(t[23], tt, tt);
-    for (i = 0; i < 6; i++) fpsqr_mont(tt, tt);
-    fpmul_mont(t[2], tt, tt);
-    for (i = 0; i < 9; i++) fpsqr_mont(tt, tt);
-    fpmul_mont(t[2], tt, tt);
-    for (i = 0; i < 10; i++) fpsqr_mont(tt, tt);
-    fpmul_mont(t[15], tt, tt);
-    for (i = 0; i < 8; i++) fpsqr_mont(tt, tt);
-    fpmul_mont(t[13], tt, tt);
-    for (i = 0; i < 8; i++) fpsqr_mont(tt, tt);
-    fpmul_mont(t[26], tt, tt);
-    for (i = 0; i < 8; i++) fpsqr_mont(tt, tt);
-    fpmul_mont(t[20], tt, tt);
-    for (i = 0; i < 6; i++) fpsqr_mont(tt, tt);
-    fpmul_mont(t[11], tt, tt);
-    for (i = 0; i < 6; i++) fpsqr_mont(tt, tt);
-    fpmul_mont(t[10], tt, tt);
-    for (i = 0; i < 6; i++) fpsqr_mont(tt, tt);
-    fpmul_mont(t[14], tt, tt);
-    for (i = 0; i < 6; i++) fpsqr_mont(tt, tt);
-    fpmul_mont(t[4], tt, tt);
-    for (i = 0; i < 10; i++) fpsqr_mont(tt, tt);
-    fpmul_mont(t[18], tt, tt);
-    for (i = 0; i < 6; i++) fpsqr_mont(tt, tt);
-    fpmul_mont(t[1], tt, tt);
-    for (i = 0; i < 7; i++) fpsqr_mont(tt, tt);
-    fpmul_mont(t[22], tt, tt);
-    for (i = 0; i < 10; i++) fpsqr_mont(tt, tt);
-    fpmul_mont(t[6], tt, tt);
-    for (i = 0; i < 7; i++) fpsqr_mont(tt, tt);
-    fpmul_mont(t[24], tt, tt);
-    for (i = 0; i < 6; i++) fpsqr_mont(tt, tt);
-    fpmul_mont(t[9], tt, tt);
-    for (i = 0; i < 8; i++) fpsqr_mont(tt, tt);
-    fpmul_mont(t[18], tt, tt);
-    for (i = 0; i < 6; i++) fpsqr_mont(tt, tt);
-    fpmul_mont(t[17], tt, tt);
-    for (i = 0; i < 8; i++) fpsqr_mont(tt, tt);
-    fpmul_mont(a, tt, tt);
-    for (i = 0; i < 10; i++) fpsqr_mont(tt, tt);
-    fpmul_mont(t[16], tt, tt);
-    for (i = 0; i < 6; i++) fpsqr_mont(tt, tt);
-    fpmul_mont(t[7], tt, tt);
-    for (i = 0; i < 6; i++) fpsqr_mont(tt, tt);
-    fpmul_mont(t[0], tt, tt);
-    for (i = 0; i < 7; i++) fpsqr_mont(tt, tt);
-    fpmul_mont(t[12], tt, tt);
-    for (i = 0; i < 7; i++) fpsqr_mont(tt, tt);
-    fpmul_mont(t[19], tt, tt);
-    for (i = 0; i < 6; i++) fpsqr_mont(tt, tt);
-    fpmul_mont(t[22], tt, tt);
-    for (i = 0; i < 6; i++) fpsqr_mont(tt, tt);
-    fpmul_mont(t[25], tt, tt);
-    for (i = 0; i < 7; i++) fpsqr_mont(tt, tt);
-    fpmul_mont(t[2], tt, tt);
-    for (i = 0; i < 6; i++) fpsqr_mont(tt, tt);
-    fpmul_mont(t[10], tt, tt);
-    for (i = 0; i < 7; i++) fpsqr_mont(tt, tt);
-    fpmul_mont(t[22], tt, tt);
-    for (i = 0; i < 8; i++) fpsqr_mont(tt, tt);
-    fpmul_mont(t[18], tt, tt);
-    for (i = 0; i < 6; i++) fpsqr_mont(tt, tt);
-    fpmul_mont(t[4], tt, tt);
-    for (i = 0; i < 6; i++) fpsqr_mont(tt, tt);
-    fpmul_mont(t[14], tt, tt);
-    for (i = 0; i < 7; i++) fpsqr_mont(tt, tt);
-    fpmul_mont(t[13], tt, tt);
-    for (i = 0; i < 6; i++) fpsqr_mont(tt, tt);
-    fpmul_mont(t[5], tt, tt);
-    for (i = 0; i < 6; i++) fpsqr_mont(tt, tt);
-    fpmul_mont(t[23], tt, tt);
-    for (i = 0; i < 6; i++) fpsqr_mont(tt, tt);
-    fpmul_mont(t[21], tt, tt);
-    for (i = 0; i < 6; i++) fpsqr_mont(tt, tt);
-    fpmul_mont(t[2], tt, tt);
-    for (i = 0; i < 7; i++) fpsqr_mont(tt, tt);
-    fpmul_mont(t[23], tt, tt);
-    for (i = 0; i < 8; i++) fpsqr_mont(tt, tt);
-    fpmul_mont(t[12], tt, tt);
-    for (i = 0; i < 6; i++) fpsqr_mont(tt, tt);
-    fpmul_mont(t[9], tt, tt);
-    for (i = 0; i < 6; i++) fpsqr_mont(tt, tt);
-    fpmul_mont(t[3], tt, tt);
-    for (i = 0; i < 7; i++) fpsqr_mont(tt, tt);
-    fpmul_mont(t[13], tt, tt);
-    for (i = 0; i < 7; i++) fpsqr_mont(tt, tt);
-    fpmul_mont(t[17], tt, tt);
-    for (i = 0; i < 8; i++) fpsqr_mont(tt, tt);
-    fpmul_mont(t[26], tt, tt);
-    for (i = 0; i < 8; i++) fpsqr_mont(tt, tt);
-    fpmul_mont(t[5], tt, tt);
-    for (i = 0; i < 8; i++) fpsqr_mont(tt, tt);
-    fpmul_mont(t[8], tt, tt);
-    for (i = 0; i < 6; i++) fpsqr_mont(tt, tt);
-    fpmul_mont(t[2], tt, tt);
-    for (i = 0; i < 6; i++) fpsqr_mont(tt, tt);
-    fpmul_mont(t[11], tt, tt);
-    for (i = 0; i < 7; i++) fpsqr_mont(tt, tt);
-    fpmul_mont(t[20], tt, tt);
-    for (j = 0; j < 61; j++) {
-        for (i = 0; i < 6; i++) fpsqr_mont(tt, tt);
-        fpmul_mont(t[26], tt, tt);
-    }
-    fpcopy(tt, a);  
-}
+#include "fpinv_chain.c"
 
 
 void fp2inv_mont(f2elm_t a)
@@ -378,6 +424,188 @@ void from_fp2mont(const f2elm_t ma, f2elm_t c)
 }
 
 
+/************ Exponentiation, square roots and quadratic residuosity *************/
+
+#define FPEXP_WINDOW          4                     // Window of fpexp_mont and fp2exp_mont, tables of 2^FPEXP_WINDOW powers
+
+static __inline digit_t window_mask(const digit_t w, const digit_t j)
+{ // Returns all ones if w = j, 0 otherwise, in constant time
+    digit_t d = w ^ j;
+
+    return (digit_t)0 - (((d | ((digit_t)0 - d)) >> (RADIX-1)) ^ 1);
+}
+
+
+static __inline digit_t exponent_window(const digit_t* e, const unsigned int nbits, const unsigned int pos)
+{ // Bits pos, ..., pos+FPEXP_WINDOW-1 of the exponent e of nbits bits, bits beyond nbits are zero
+    digit_t w = 0;
+    unsigned int i;
+
+    for (i = 0; i < FPEXP_WINDOW && pos + i < nbits; i++) {
+        w |= ((e[(pos + i) >> LOG2RADIX] >> ((pos + i) & (RADIX-1))) & 1) << i;
+    }
+    return w;
+}
+
+
+void fpexp_mont(const felm_t a, const digit_t* e, const unsigned int nbits, felm_t c)
+{ // Exponentiation c = a^e in GF(p) using Montgomery arithmetic, for an exponent e of nbits bits.
+  // Fixed windows of FPEXP_WINDOW bits from the most significant one, every table entry is read for every window,
+  // so the running time only depends on nbits.
+    felm_t table[1 << FPEXP_WINDOW], t;
+    digit_t w, mask;
+    unsigned int i, j, k, nwin = (nbits + FPEXP_WINDOW - 1)/FPEXP_WINDOW;
+
+    fpcopy((digit_t*)&Montgomery_one, table[0]);     // table[j] = a^j
+    fpcopy(a, table[1]);
+    for (j = 2; j < (1 << FPEXP_WINDOW); j++) {
+        fpmul_mont(table[j-1], a, table[j]);
+    }
+
+    fpcopy((digit_t*)&Montgomery_one, c);
+    for (i = nwin; i > 0; i--) {
+        if (i < nwin) {
+            for (k = 0; k < FPEXP_WINDOW; k++) fpsqr_mont(c, c);
+        }
+        w = exponent_window(e, nbits, (i-1)*FPEXP_WINDOW);
+        fpzero(t);
+        for (j = 0; j < (1 << FPEXP_WINDOW); j++) {
+            mask = window_mask(w, j);
+            for (k = 0; k < NWORDS_FIELD; k++) t[k] |= table[j][k] & mask;
+        }
+        fpmul_mont(c, t, c);
+    }
+}
+
+
+void fp2exp_mont(const f2elm_t a, const digit_t* e, const unsigned int nbits, f2elm_t c)
+{ // Exponentiation c = a^e in GF(p^2) using Montgomery arithmetic, for an exponent e of nbits bits.
+  // Same fixed windows as fpexp_mont, the running time only depends on nbits.
+    f2elm_t table[1 << FPEXP_WINDOW], t;
+    digit_t w, mask;
+    unsigned int i, j, k, nwin = (nbits + FPEXP_WINDOW - 1)/FPEXP_WINDOW;
+
+    fp2zero(table[0]);                               // table[j] = a^j
+    fpcopy((digit_t*)&Montgomery_one, table[0][0]);
+    fp2copy(a, table[1]);
+    for (j = 2; j < (1 << FPEXP_WINDOW); j++) {
+        fp2mul_mont(table[j-1], a, table[j]);
+    }
+
+    fp2copy(table[0], c);
+    for (i = nwin; i > 0; i--) {
+        if (i < nwin) {
+            for (k = 0; k < FPEXP_WINDOW; k++) fp2sqr_mont(c, c);
+        }
+        w = exponent_window(e, nbits, (i-1)*FPEXP_WINDOW);
+        fp2zero(t);
+        for (j = 0; j < (1 << FPEXP_WINDOW); j++) {
+            mask = window_mask(w, j);
+            for (k = 0; k < NWORDS_FIELD; k++) {
+                t[0][k] |= table[j][0][k] & mask;
+                t[1][k] |= table[j][1][k] & mask;
+            }
+        }
+        fp2mul_mont(c, t, c);
+    }
+}
+
+
+void fpsqrt_mont(const felm_t a, felm_t c)
+{ // Square root in GF(p) using Montgomery arithmetic, c = a^((p+1)/4) = a*a^((p-3)/4) with the chain of fpinv_chain.c.
+  // c^2 = a if a is a square, c^2 = -a otherwise, as -1 is not a square for p = 3 mod 4.
+    felm_t t;
+
+    fpcopy(a, t);
+    fpinv_chain_mont(t);
+    fpmul_mont(a, t, c);
+}
+
+
+static __inline void fpselect(const felm_t a, const felm_t b, const digit_t mask, felm_t c)
+{ // c = a if mask is all ones, c = b if mask = 0, in constant time
+    unsigned int i;
+
+    for (i = 0; i < NWORDS_FIELD; i++) c[i] = b[i] ^ ((a[i] ^ b[i]) & mask);
+}
+
+
+static __inline digit_t fpequal_mask(const felm_t a, const felm_t b)
+{ // Returns all ones if a = b, 0 otherwise, in constant time. a and b in [0, p-1]
+    digit_t r = 0;
+    unsigned int i;
+
+    for (i = 0; i < NWORDS_FIELD; i++) r |= a[i] ^ b[i];
+    return window_mask(r, 0);
+}
+
+
+int fp_legendre(const felm_t a)
+{ // Legendre symbol (a/p) = a^((p-1)/2) = a*(a^((p-3)/4))^2 with the chain of fpinv_chain.c, in constant time.
+  // Returns 1 if a is a nonzero square, -1 if it is not a square and 0 if a = 0.
+    felm_t t, zero = {0};
+    digit_t is_one, is_zero;
+
+    fpcopy(a, t);
+    fpinv_chain_mont(t);
+    fpsqr_mont(t, t);
+    fpmul_mont(a, t, t);
+    fpcorrection(t);
+    is_one = fpequal_mask(t, (digit_t*)&Montgomery_one) & 1;
+    is_zero = fpequal_mask(t, zero) & 1;
+    return (int)(2*is_one + is_zero) - 1;
+}
+
+
+unsigned int fp2_is_square(const f2elm_t a)
+{ // Is a a square in GF(p^2)? This is the case if and only if its norm a0^2+a1^2 is a square in GF(p).
+  // Returns 1 (TRUE) if a is a square, including a = 0, and 0 (FALSE) otherwise, in constant time.
+    felm_t n, t;
+
+    fpsqr_mont(a[0], n);
+    fpsqr_mont(a[1], t);
+    fpadd(n, t, n);
+    return (unsigned int)(fp_legendre(n) + 2) >> 1;
+}
+
+
+void fp2sqrt(const f2elm_t a, f2elm_t c)
+{ // Square root in GF(p^2) using Montgomery arithmetic, c^2 = a for a square a (see fp2_is_square), in constant time.
+  // With alpha = sqrt(a0^2+a1^2) and delta = (a0+alpha)/2, or delta = (a0-alpha)/2 if a0+alpha = 0, t = delta^((p-3)/4)
+  // gives both x0 = delta*t and x0^-1 = t (Hamburg's trick): c = x0+i*a1*t/2 if delta is a square, c = a1*t/2-i*x0 otherwise.
+  // The root is a fixed function of a, so two parties that compute it get the same root.
+    felm_t n, alpha, delta, t, x0, x1, zero = {0};
+    digit_t mask;
+
+    fpsqr_mont(a[0], n);                             // alpha = sqrt(a0^2+a1^2)
+    fpsqr_mont(a[1], t);
+    fpadd(n, t, n);
+    fpsqrt_mont(n, alpha);
+
+    fpadd(a[0], alpha, delta);                       // delta = (a0+alpha)/2, or (a0-alpha)/2 if a0+alpha = 0 (then a1 = 0)
+    fpsub(a[0], alpha, t);
+    fpcorrection(delta);
+    fpselect(t, delta, fpequal_mask(delta, zero), delta);
+    fpdiv2(delta, delta);
+
+    fpcopy(delta, t);                                // t = delta^((p-3)/4), x0 = delta*t, x1 = a1*t/2
+    fpinv_chain_mont(t);
+    fpmul_mont(delta, t, x0);
+    fpmul_mont(a[1], t, x1);
+    fpdiv2(x1, x1);
+
+    fpsqr_mont(x0, t);                               // Is delta a square, x0^2 = delta?
+    fpcorrection(t);
+    fpcorrection(delta);
+    mask = fpequal_mask(t, delta);
+    fpcopy(x0, t);
+    fpneg(t);
+    fpselect(x0, x1, mask, c[0]);
+    fpselect(x1, t, mask, c[1]);
+}
+
+
+
 __inline unsigned int mp_add(const digit_t* a, const digit_t* b, digit_t* c, const unsigned int nwords)
 { // Multiprecision addition, c = a+b, where lng(a) = lng(b) = nwords. Returns the carry bit.
     unsigned int i, carry = 0;
@@ -430,4 +658,345 @@ void mp_shiftl1(digit_t* x, const unsigned int nwords)
         SHIFTL(x[i], x[i-1], 1, x[i], RADIX);
     }
     x[0] <<= 1;
-}
\ No newline at end of file
+}
+
+static __inline unsigned int is_felm_zero(const felm_t x)
+{ // Is x = 0? return 1 (TRUE) if condition is true, 0 (FALSE) otherwise.
+  // SECURITY NOTE: This function does not run in constant-time.
+    unsigned int i;
+
+    for (i = 0; i < NWORDS_FIELD; i++) {
+        if (x[i] != 0) return false;
+    }
+    return true;
+}
+
+
+static __inline unsigned int is_felm_even(const felm_t x)
+{ // Is x even? return 1 (TRUE) if condition is true, 0 (FALSE) otherwise.
+    return (unsigned int)((x[0] & 1) ^ 1);
+}
+
+
+static __inline unsigned int is_felm_lt(const felm_t x, const felm_t y)
+{ // Is x < y? return 1 (TRUE) if condition is true, 0 (FALSE) otherwise.
+  // SECURITY NOTE: This function does not run in constant-time.
+    int i;
+
+    for (i = NWORDS_FIELD-1; i >= 0; i--) {
+        if (x[i] < y[i]) { 
+            return true;
+        } else if (x[i] > y[i]) {
+            return false;
+        }
+    }
+    return false;
+}
+
+
+static void power2_setup(digit_t* x, const unsigned int mark, const unsigned int nwords)
+{ // Set up the value 2^mark, where mark < nwords*RADIX.
+    unsigned int i;
+
+    for (i = 0; i < nwords; i++) x[i] = 0;
+    x[mark/RADIX] = (digit_t)1 << (mark % RADIX);
+}
+
+
+static void fpinv_mont_bingcd_partial(const felm_t a, felm_t x1, unsigned int* k)
+{ // Partial Montgomery inversion via the binary GCD algorithm, x1 = a^(-1)*2^k mod p. 
+  // Input: a in [1, p-1]. Output: x1 in [1, p-1] and k <= 2*NBITS_FIELD, since every step halves u*v < p^2.
+  // Invariants: a*x1 = u*2^k and a*x2 = -v*2^k (mod p), and p = x1*v + x2*u.
+    felm_t u, v, x2;
+    unsigned int cwords;                             // Number of words necessary for x1, x2
+
+    fpcopy(a, u);
+    fpcopy((digit_t*)PRIME, v);
+    fpzero(x1); x1[0] = 1;
+    fpzero(x2);
+    *k = 0;
+
+    while (!is_felm_zero(v)) {
+        cwords = ((*k + 1) / RADIX) + 1;
+        if (cwords > NWORDS_FIELD) cwords = NWORDS_FIELD;
+        if (is_felm_even(v)) {
+            mp_shiftr1(v, NWORDS_FIELD);
+            mp_shiftl1(x1, cwords);
+        } else if (is_felm_even(u)) {
+            mp_shiftr1(u, NWORDS_FIELD);
+            mp_shiftl1(x2, cwords);
+        } else if (!is_felm_lt(v, u)) {
+            mp_sub(v, u, v, NWORDS_FIELD);
+            mp_shiftr1(v, NWORDS_FIELD);
+            mp_add(x1, x2, x2, cwords);
+            mp_shiftl1(x1, cwords);
+        } else {
+            mp_sub(u, v, u, NWORDS_FIELD);
+            mp_shiftr1(u, NWORDS_FIELD);
+            mp_add(x1, x2, x1, cwords);
+            mp_shiftl1(x2, cwords);
+        }
+        *k += 1;
+    }
+
+    if (!is_felm_lt(x1, (digit_t*)PRIME)) {          // x1 < 2*p after the last step
+        mp_sub(x1, (digit_t*)PRIME, x1, NWORDS_FIELD);
+    }
+}
+
+
+void fpinv_mont_bingcd(felm_t a)
+{ // Field inversion via the binary GCD using Montgomery arithmetic, a = a^(-1)*R mod p. 
+  // Input: a in [0, 2*p-1]. Output: a in [0, 2*p-1], 0 is mapped to 0.
+  // SECURITY NOTE: This function does not run in constant-time and is therefore only suitable for 
+  //                operations not involving any secret data.
+    felm_t x, t;
+    unsigned int k;
+
+#if defined(BINGCD_TRACE)
+    BINGCD_TRACE(a);                                 // Test hook, see tests/arith_tests.c
+#endif
+    fpcopy(a, x);
+    fpcorrection(x);
+    if (is_felm_zero(x)) {
+        fpzero(a);
+        return;
+    }
+    fpinv_mont_bingcd_partial(x, x, &k);             // x = (a*R)^(-1)*2^k
+    if (k <= NWORDS_FIELD*RADIX) { 
+        fpmul_mont(x, (digit_t*)&Montgomery_R2, x);
+        k += NWORDS_FIELD*RADIX;
+    }
+    fpmul_mont(x, (digit_t*)&Montgomery_R2, x);      // x = (a*R)^(-1)*2^(k+RADIX*NWORDS_FIELD), where 2^k in (R, R^2]
+    power2_setup(t, 2*NWORDS_FIELD*RADIX - k, NWORDS_FIELD);
+    fpmul_mont(x, t, a);                             // a = (a*R)^(-1)*R^2
+}
+
+
+void fp2inv_mont_bingcd(f2elm_t a)
+{// GF(p^2) inversion using Montgomery arithmetic, a = (a0-i*a1)/(a0^2+a1^2).
+ // This uses the binary GCD for inversion in fp and is NOT constant time!!!
+    f2elm_t t1;
+
+    fpsqr_mont(a[0], t1[0]);                         // t10 = a0^2
+    fpsqr_mont(a[1], t1[1]);                         // t11 = a1^2
+    fpadd(t1[0], t1[1], t1[0]);                      // t10 = a0^2+a1^2
+    fpinv_mont_bingcd(t1[0]);                        // t10 = (a0^2+a1^2)^-1
+    fpneg(a[1]);                                     // a = a0-i*a1
+    fpmul_mont(a[0], t1[0], a[0]);
+    fpmul_mont(a[1], t1[0], a[1]);                   // a = (a0-i*a1)*(a0^2+a1^2)^-1
+}
+
+
+static void n_way_inv(const f2elm_t* vec, const int n, f2elm_t* out, void (*inv)(f2elm_t), const felm_t* mask)
+{ // n-way simultaneous inversion using Montgomery's trick, out[i] = 1/vec[i], with one call to inv and 3*(n-1) multiplications.
+  // out holds the partial products vec[0]*...*vec[i], so no scratch space other than two temporaries is needed. out must not overlap vec.
+  // If mask != NULL, the product of all vec[i] is multiplied by the GF(p^2) element mask before inversion. 
+    f2elm_t t0, t1;
+    int i;
+
+    fp2copy(vec[0], out[0]);
+    for (i = 1; i < n; i++) {
+        fp2mul_mont(out[i-1], vec[i], out[i]);      // out[i] = vec[0]*...*vec[i]
+    }
+    fp2copy(out[n-1], t0);
+    if (mask != NULL) fp2mul_mont(t0, mask, t0);
+    inv(t0);                                         // t0 = 1/(vec[0]*...*vec[n-1])
+    if (mask != NULL) fp2mul_mont(t0, mask, t0);
+    for (i = n-1; i > 0; i--) {
+        fp2mul_mont(out[i-1], t0, t1);               // t1 = 1/vec[i]
+        fp2mul_mont(t0, vec[i], t0);                 // t0 = 1/(vec[0]*...*vec[i-1])
+        fp2copy(t1, out[i]);
+    }
+    fp2copy(t0, out[0]);
+}
+
+
+void mont_n_way_inv(const f2elm_t* vec, const int n, f2elm_t* out)
+{ // n-way simultaneous inversion, out[i] = 1/vec[i] for i = 0,...,n-1. All vec[i] must be nonzero.
+  // The output array is used as scratch space and must not overlap vec.
+    n_way_inv(vec, n, out, fp2inv_mont, NULL);
+}
+
+
+void mont_n_way_inv_bingcd(const f2elm_t* vec, const int n, f2elm_t* out, const f2elm_t mask)
+{ // n-way simultaneous inversion, out[i] = 1/vec[i] for i = 0,...,n-1, using the variable-time GF(p^2) inversion. 
+  // The product of all vec[i] is multiplied by mask before inversion, so that only public or masked values reach it.
+  // SECURITY NOTE: if vec depends on secret data, mask must be nonzero and unknown to the adversary.
+    n_way_inv(vec, n, out, fp2inv_mont_bingcd, mask);
+}
+
+
+static __inline unsigned int is_zero_mod_order(const digit_t* x)
+{ // Is x = 0? return 1 (TRUE) if condition is true, 0 (FALSE) otherwise
+  // SECURITY NOTE: This function does not run in constant time.
+    unsigned int i;
+
+    for (i = 0; i < NWORDS_ORDER; i++) {
+        if (x[i] != 0) return false;
+    }
+    return true;
+}
+
+
+static __inline unsigned int is_even_mod_order(const digit_t* x)
+{ // Is x even? return 1 (TRUE) if condition is true, 0 (FALSE) otherwise.
+    return (unsigned int)((x[0] & 1) ^ 1);
+}
+
+
+static __inline unsigned int is_lt_mod_order(const digit_t* x, const digit_t* y)
+{ // Is x < y? return 1 (TRUE) if condition is true, 0 (FALSE) otherwise.
+  // SECURITY NOTE: This function does not run in constant time.
+    int i;
+
+    for (i = NWORDS_ORDER-1; i >= 0; i--) {
+        if (x[i] < y[i]) { 
+            return true;
+        } else if (x[i] > y[i]) {
+            return false;
+        }
+    }
+    return false;
+}
+
+
+static void mp_mul_order(const digit_t* a, const digit_t* b, digit_t* c)
+{ // Comba multiplication of NWORDS_ORDER-word integers, c = a*b. 
+  // The mp_mul kernels are specialized to NWORDS_FIELD-word operands and cannot be used here.
+    unsigned int i, j, carry;
+    digit_t t = 0, u = 0, v = 0, UV[2];
+    
+    for (i = 0; i < NWORDS_ORDER; i++) {
+        for (j = 0; j <= i; j++) {
+            MUL(a[j], b[i-j], UV+1, UV[0]); 
+            ADDC(0, UV[0], v, carry, v); 
+            ADDC(carry, UV[1], u, carry, u); 
+            t += carry;
+        }
+        c[i] = v;
+        v = u; 
+        u = t;
+        t = 0;
+    }
+    for (i = NWORDS_ORDER; i < 2*NWORDS_ORDER-1; i++) {
+        for (j = i-NWORDS_ORDER+1; j < NWORDS_ORDER; j++) {
+            MUL(a[j], b[i-j], UV+1, UV[0]); 
+            ADDC(0, UV[0], v, carry, v); 
+            ADDC(carry, UV[1], u, carry, u); 
+            t += carry;
+        }
+        c[i] = v;
+        v = u; 
+        u = t;
+        t = 0;
+    }
+    c[2*NWORDS_ORDER-1] = v;
+}
+
+
+void Montgomery_multiply_mod_order(const digit_t* ma, const digit_t* mb, digit_t* mc, const digit_t* order, const digit_t* Montgomery_rprime)
+{ // Montgomery multiplication modulo the group order, mc = ma*mb*r' mod order, where ma,mb,mc in [0, order-1].
+  // ma, mb and mc are assumed to be in Montgomery representation.
+  // The Montgomery constant r' = -r^(-1) mod 2^(log_2(r)) is the global value "Montgomery_rprime", where r is the order.   
+    unsigned int i, cout = 0, bout = 0;
+    digit_t mask, P[2*NWORDS_ORDER], Q[2*NWORDS_ORDER], temp[2*NWORDS_ORDER];
+
+    mp_mul_order(ma, mb, P);                             // P = ma * mb
+    mp_mul_order(P, Montgomery_rprime, Q);               // Q = P * r' mod 2^(log_2(r))
+    mp_mul_order(Q, order, temp);                        // temp = Q * r
+    cout = mp_add(P, temp, temp, 2*NWORDS_ORDER);        // (cout, temp) = P + Q * r     
+
+    for (i = 0; i < NWORDS_ORDER; i++) {                 // (cout, mc) = (P + Q * r)/2^(log_2(r))
+        mc[i] = temp[NWORDS_ORDER + i];
+    }
+
+    // Final, constant-time subtraction     
+    bout = mp_sub(mc, order, mc, NWORDS_ORDER);          // (cout, mc) = (cout, mc) - r
+    mask = (digit_t)cout - (digit_t)bout;                // if (cout, mc) >= 0 then mask = 0x00..0, else if (cout, mc) < 0 then mask = 0xFF..F
+    
+    for (i = 0; i < NWORDS_ORDER; i++) {                 // temp = mask & r
+        temp[i] = (order[i] & mask);
+    }
+    mp_add(mc, temp, mc, NWORDS_ORDER);                  //  mc = mc + (mask & r)
+}
+
+
+void to_Montgomery_mod_order(const digit_t* a, digit_t* mc, const digit_t* order, const digit_t* Montgomery_rprime, const digit_t* Montgomery_Rprime)
+{ // Conversion of elements in Z_r to Montgomery representation, where the order r is up to NBITS_ORDER bits.
+  // Montgomery_Rprime = (2^NBITS_ORDER)^2 mod order.
+
+    Montgomery_multiply_mod_order(a, Montgomery_Rprime, mc, order, Montgomery_rprime);
+}
+
+
+void from_Montgomery_mod_order(const digit_t* ma, digit_t* c, const digit_t* order, const digit_t* Montgomery_rprime)
+{ // Conversion of elements in Z_r from Montgomery to standard representation, where the order is up to NBITS_ORDER bits.
+    digit_t one[NWORDS_ORDER] = {0};
+    one[0] = 1;
+
+    Montgomery_multiply_mod_order(ma, one, c, order, Montgomery_rprime);
+}
+
+
+static void Montgomery_inversion_mod_order_bingcd_partial(const digit_t* a, digit_t* x1, unsigned int* k, const digit_t* order)
+{ // Partial Montgomery inversion modulo order, x1 = a^(-1)*2^k mod order, for an odd order and a in [1, order-1].
+    digit_t u[NWORDS_ORDER], v[NWORDS_ORDER], x2[NWORDS_ORDER] = {0};
+    unsigned int cwords;                                 // Number of words necessary for x1, x2
+
+    copy_words(a, u, NWORDS_ORDER);
+    copy_words(order, v, NWORDS_ORDER);
+    copy_words(x2, x1, NWORDS_ORDER);
+    x1[0] = 1;
+    *k = 0;
+
+    while (!is_zero_mod_order(v)) {
+        cwords = ((*k + 1) / RADIX) + 1;
+        if (cwords > NWORDS_ORDER) cwords = NWORDS_ORDER;
+        if (is_even_mod_order(v)) {
+            mp_shiftr1(v, NWORDS_ORDER);
+            mp_shiftl1(x1, cwords);
+        } else if (is_even_mod_order(u)) {
+            mp_shiftr1(u, NWORDS_ORDER);
+            mp_shiftl1(x2, cwords);
+        } else if (!is_lt_mod_order(v, u)) {
+            mp_sub(v, u, v, NWORDS_ORDER);
+            mp_shiftr1(v, NWORDS_ORDER);
+            mp_add(x1, x2, x2, cwords);
+            mp_shiftl1(x1, cwords);
+        } else {
+            mp_sub(u, v, u, NWORDS_ORDER);
+            mp_shiftr1(u, NWORDS_ORDER);
+            mp_add(x1, x2, x1, cwords);
+            mp_shiftl1(x2, cwords);
+        }
+        *k += 1;
+    }
+
+    if (!is_lt_mod_order(x1, order)) {
+        mp_sub(x1, order, x1, NWORDS_ORDER);
+    }
+}
+
+
+void Montgomery_inversion_mod_order_bingcd(const digit_t* a, digit_t* c, const digit_t* order, const digit_t* Montgomery_rprime, const digit_t* Montgomery_R2)
+{// Montgomery inversion modulo order, c = a^(-1)*R mod order, where a = a*R is in Montgomery representation and R = 2^(RADIX*NWORDS_ORDER).
+ // The order must be odd, and a must be invertible modulo the order. Montgomery_R2 = R^2 mod order. 0 is mapped to 0.
+ // SECURITY NOTE: This function does not run in constant-time and is therefore only suitable for 
+ //                operations not involving any secret data.
+    digit_t x[NWORDS_ORDER], t[NWORDS_ORDER];
+    unsigned int k;
+
+    if (is_zero_mod_order(a)) {
+        for (k = 0; k < NWORDS_ORDER; k++) c[k] = 0;
+        return;
+    }
+    Montgomery_inversion_mod_order_bingcd_partial(a, x, &k, order);
+    if (k <= NWORDS_ORDER*RADIX) { 
+        Montgomery_multiply_mod_order(x, Montgomery_R2, x, order, Montgomery_rprime);
+        k += NWORDS_ORDER*RADIX;
+    }
+    Montgomery_multiply_mod_order(x, Montgomery_R2, x, order, Montgomery_rprime);
+    power2_setup(t, 2*NWORDS_ORDER*RADIX - k, NWORDS_ORDER);
+    Montgomery_multiply_mod_order(x, t, c, order, Montgomery_rprime);
+}
@@ -6,6 +6,7 @@
 
 #include "P751_internal.h"
 #include "random/random.h"
+#include "sha3/fips202.h"
 
 
 static void clear_words(void* mem, digit_t nwords)
@@ -58,6 +59,207 @@ static void fp2_decode(const unsigned char *enc, f2elm_t x)
 }
 
 
+static void keygen_mask(const unsigned char* PrivateKey, const unsigned int nbytes, f2elm_t mask)
+{ // Nonzero mask in GF(p^2) for the normalization of a public key, derived from the private key with cSHAKE256. 
+  // It hides the projective Z coordinates from the variable-time inversion in inv_3_way_bingcd.
+    const uint16_t M = 3;
+
+    cshake256_simple((unsigned char*)mask, 2*NWORDS_FIELD*sizeof(digit_t), M, PrivateKey, nbytes);
+    mask[0][NWORDS_FIELD-1] &= (digit_t)(-1) >> (NWORDS_FIELD*RADIX - NBITS_FIELD + 1);    // mask_i < 2^(NBITS_FIELD-1) < p
+    mask[1][NWORDS_FIELD-1] &= (digit_t)(-1) >> (NWORDS_FIELD*RADIX - NBITS_FIELD + 1);
+    mask[0][0] |= 1;
+}
+
+
+/********************************************************************************************
+* Tree traversal on several cores. The isogeny evaluations of every row of the strategy are
+* independent. With ISOG_THREADS=2, 3 or 4 (Makefile) they run on a persistent pool of
+* ISOG_THREADS-1 worker threads, while the calling thread evaluates the next kernel point and
+* runs the xDBLe/xTPLe chain of the next row. The calling thread then helps with the
+* evaluations that are left, and waits for all of them before the next isogeny. Tasks are
+* claimed with compare-and-swap and counted with atomic increments, so the rows take no lock.
+* The workers sleep between key operations. If another key operation owns the pool, the
+* traversal runs on the calling thread only.
+*********************************************************************************************/
+
+#define ISOG_TASKS_MAX    (((MAX_INT_POINTS_ALICE > MAX_INT_POINTS_BOB) ? MAX_INT_POINTS_ALICE : MAX_INT_POINTS_BOB) + 3)
+
+typedef struct {
+    unsigned int degree;                   // 4 for eval_4_isog, 3 for eval_3_isog
+    f2elm_t coeff[3];
+    point_proj* tasks[ISOG_TASKS_MAX];     // Points evaluated in place
+} isog_job_t;
+
+
+static void isog_eval_task(const isog_job_t* job, unsigned int i)
+{
+    if (job->degree == 4) {
+        eval_4_isog(job->tasks[i], (f2elm_t*)job->coeff);
+    } else {
+        eval_3_isog(job->tasks[i], job->coeff);
+    }
+}
+
+
+#if defined(_ISOG_THREADS_)
+#include <pthread.h>
+#include <sched.h>
+
+#define ISOG_SPINS    1024                 // Spins before a waiting thread yields its core
+
+typedef struct {
+    isog_job_t job;
+    uint64_t state;                        // Row generation << 16 | number of tasks << 8 | next task
+    unsigned int done;                     // Tasks of the current row evaluated
+    unsigned int active;                   // Workers wait for tasks while a key operation owns the pool
+    pthread_mutex_t owner;
+    pthread_mutex_t sleep;
+    pthread_cond_t wake;
+} isog_pool_t;
+
+static isog_pool_t isog_pool = { .owner = PTHREAD_MUTEX_INITIALIZER, .sleep = PTHREAD_MUTEX_INITIALIZER, .wake = PTHREAD_COND_INITIALIZER };
+static pthread_once_t isog_pool_once = PTHREAD_ONCE_INIT;
+static unsigned int isog_workers = 0;
+
+
+static __inline void isog_relax(unsigned int* spins)
+{ // Spins on the core for a while, then lets other threads run if there are more threads than cores
+    if (++(*spins) < ISOG_SPINS) {
+#if (TARGET == TARGET_ARM64)
+        __asm__ __volatile__ ("yield");
+#elif (TARGET == TARGET_AMD64)
+        __asm__ __volatile__ ("pause");
+#endif
+    } else {
+        *spins = 0;
+        sched_yield();
+    }
+}
+
+
+static unsigned int isog_pool_work(isog_pool_t* pool)
+{ // Evaluates tasks of the current row until all of them are claimed, returns the number of tasks evaluated
+    unsigned int n = 0;
+    uint64_t s = __atomic_load_n(&pool->state, __ATOMIC_ACQUIRE);
+
+    while ((s & 0xFF) < ((s >> 8) & 0xFF)) {
+        if (__atomic_compare_exchange_n(&pool->state, &s, s + 1, 0, __ATOMIC_ACQUIRE, __ATOMIC_ACQUIRE)) {
+            isog_eval_task(&pool->job, (unsigned int)(s & 0xFF));
+            __atomic_fetch_add(&pool->done, 1, __ATOMIC_RELEASE);
+            s = __atomic_load_n(&pool->state, __ATOMIC_ACQUIRE);
+            n++;
+        }
+    }
+    return n;
+}
+
+
+static void* isog_worker(void* arg)
+{
+    isog_pool_t* pool = (isog_pool_t*)arg;
+    unsigned int spins = 0;
+
+    for (;;) {
+        if (__atomic_load_n(&pool->active, __ATOMIC_ACQUIRE) == 0) {
+            pthread_mutex_lock(&pool->sleep);
+            while (__atomic_load_n(&pool->active, __ATOMIC_ACQUIRE) == 0) {
+                pthread_cond_wait(&pool->wake, &pool->sleep);
+            }
+            pthread_mutex_unlock(&pool->sleep);
+        }
+        if (isog_pool_work(pool) != 0) {
+            spins = 0;
+        }
+        isog_relax(&spins);
+    }
+    return NULL;
+}
+
+
+static void isog_pool_init(void)
+{
+    unsigned int i;
+    pthread_t thread;
+
+    for (i = 0; i < _ISOG_THREADS_ - 1; i++) {
+        if (pthread_create(&thread, NULL, isog_worker, &isog_pool) != 0) break;
+        pthread_detach(thread);
+        isog_workers++;
+    }
+}
+
+
+static isog_pool_t* isog_pool_acquire(void)
+{ // The worker pool for one key operation, NULL if there are no workers or another key operation owns them
+    pthread_once(&isog_pool_once, isog_pool_init);
+    if (isog_workers == 0 || pthread_mutex_trylock(&isog_pool.owner) != 0) return NULL;
+
+    pthread_mutex_lock(&isog_pool.sleep);
+    __atomic_store_n(&isog_pool.active, 1, __ATOMIC_RELEASE);
+    pthread_cond_broadcast(&isog_pool.wake);
+    pthread_mutex_unlock(&isog_pool.sleep);
+    return &isog_pool;
+}
+
+
+static void isog_sync(isog_pool_t* pool)
+{ // Barrier at the end of a row: helps with its last tasks and waits for the workers
+    unsigned int ntasks, spins = 0;
+
+    if (pool == NULL) return;
+    isog_pool_work(pool);
+    ntasks = (unsigned int)(__atomic_load_n(&pool->state, __ATOMIC_ACQUIRE) >> 8) & 0xFF;
+    while (__atomic_load_n(&pool->done, __ATOMIC_ACQUIRE) < ntasks) {
+        isog_relax(&spins);
+    }
+}
+
+
+static void isog_run(isog_pool_t* pool, const isog_job_t* job, unsigned int ntasks)
+{ // Starts the evaluation of a row. Without a pool the row is evaluated at once.
+  // The previous row must have been completed with isog_sync().
+    unsigned int i;
+    uint64_t generation;
+
+    if (pool == NULL) {
+        for (i = 0; i < ntasks; i++) {
+            isog_eval_task(job, i);
+        }
+        return;
+    }
+    pool->job = *job;
+    pool->done = 0;
+    generation = (__atomic_load_n(&pool->state, __ATOMIC_RELAXED) >> 16) + 1;
+    __atomic_store_n(&pool->state, (generation << 16) | ((uint64_t)ntasks << 8), __ATOMIC_RELEASE);
+}
+
+
+static void isog_pool_release(isog_pool_t* pool)
+{ // Completes the last row and puts the workers back to sleep
+    if (pool == NULL) return;
+    isog_sync(pool);
+    __atomic_store_n(&pool->active, 0, __ATOMIC_RELEASE);
+    pthread_mutex_unlock(&pool->owner);
+}
+
+#else
+typedef void isog_pool_t;
+
+static isog_pool_t* isog_pool_acquire(void) { return NULL; }
+static void isog_sync(isog_pool_t* pool) { UNREFERENCED_PARAMETER(pool); }
+static void isog_pool_release(isog_pool_t* pool) { UNREFERENCED_PARAMETER(pool); }
+
+static void isog_run(isog_pool_t* pool, const isog_job_t* job, unsigned int ntasks)
+{ // Evaluates a row on the calling thread
+    unsigned int i;
+
+    UNREFERENCED_PARAMETER(pool);
+    for (i = 0; i < ntasks; i++) {
+        isog_eval_task(job, i);
+    }
+}
+#endif
+
 void random_mod_order_A(unsigned char* random_digits)
 {  // Generation of Alice's secret key  
    // Outputs random value in [0, 2^eA - 1]
@@ -80,68 +282,313 @@ void random_mod_order_B(unsigned char* random_digits)
 }
 
 
-int EphemeralKeyGeneration_A(const unsigned char* PrivateKeyA, unsigned char* PublicKeyA)
-{ // Alice's ephemeral public key generation
-  // Input:  a private key PrivateKeyA in the range [0, 2^eA - 1]. 
-  // Output: the public key PublicKeyA consisting of 3 elements in GF(p^2) which are encoded by removing leading 0 bytes.
-    point_proj_t R, phiP = {0}, phiQ = {0}, phiR = {0}, pts[MAX_INT_POINTS_ALICE];
-    f2elm_t XPA, XQA, XRA, coeff[3], A24plus = {0}, C24 = {0}, A = {0};
-    unsigned int i, row, m, index = 0, pts_index[MAX_INT_POINTS_ALICE], npts = 0, ii = 0;
+/********************************************************************************************
+* Key operations in steps. A key generation or shared secret computation of one party is
+* kept in an isog_state_t and advanced by isog_step() one stage at a time: one bit of the
+* 3-point ladder, one doubling by 4 (Alice) or tripling (Bob) of the tree traversal, or one
+* isogeny with the evaluations of its row. A row counts for its evaluations, so that a budget
+* of steps bounds the time of a slice. The ephemeral functions below run all the steps at
+* once and the resumable KEM of sike_step.c runs them in slices, with the same ladder and
+* traversal.
+*********************************************************************************************/
+
+#define ISOG_POINTS_MAX    ((MAX_INT_POINTS_ALICE > MAX_INT_POINTS_BOB) ? MAX_INT_POINTS_ALICE : MAX_INT_POINTS_BOB)
+#define ISOG_ALL_STEPS     ((unsigned int)-1)
+
+enum { ISOG_LADDER, ISOG_TWO, ISOG_CHAIN, ISOG_ROW, ISOG_LAST, ISOG_DONE };    // Stages of a key operation
+
+typedef struct {
+    unsigned int party;                    // ALICE or BOB
+    unsigned int keygen;                   // 1 for key generation, with the images of the basis of the other party in phi
+    unsigned int stage;
+    const unsigned char* key;
+    ladder_t ladder;
+    point_proj_t R, pts[ISOG_POINTS_MAX], phi[3];
+#if (OALICE_BITS % 2 == 1)
+    point_proj_t S;                        // Kernel point of Alice's first isogeny, a 2-isogeny
+#endif
+    f2elm_t c0, c1;                        // Curve, A24plus and C24 for Alice, A24minus and A24plus for Bob
+    unsigned int pts_index[ISOG_POINTS_MAX], max, row, index, npts, run, ii;    // Tree traversal, run is what is left of the current run of the strategy
+    isog_job_t job;                        // Isogeny of the current row and its evaluations
+    f2elm_t jnum, jden;                    // j-invariant of the shared curve
+} isog_state_t;
+
+
+static void isog_start_keygen(isog_state_t* s, const unsigned int party, const unsigned char* PrivateKey)
+{ // Starts the public key generation of a party
+    f2elm_t XP, XQ, XR, A = {0};
+    unsigned int i;
+
+    s->party = party;
+    s->keygen = 1;
+    s->stage = ISOG_LADDER;
+    s->key = PrivateKey;
+    s->max = (party == ALICE) ? MAX_Alice : MAX_Bob;
+    s->job.degree = (party == ALICE) ? 4 : 3;
 
     // Initialize basis points
-    init_basis((digit_t*)A_gen, XPA, XQA, XRA);
-    init_basis((digit_t*)B_gen, phiP->X, phiQ->X, phiR->X);
-    fpcopy((digit_t*)&Montgomery_one, (phiP->Z)[0]);
-    fpcopy((digit_t*)&Montgomery_one, (phiQ->Z)[0]);
-    fpcopy((digit_t*)&Montgomery_one, (phiR->Z)[0]);
+    init_basis((digit_t*)((party == ALICE) ? A_gen : B_gen), XP, XQ, XR);
+    init_basis((digit_t*)((party == ALICE) ? B_gen : A_gen), s->phi[0]->X, s->phi[1]->X, s->phi[2]->X);
+    for (i = 0; i < 3; i++) {
+        fp2zero(s->phi[i]->Z);
+        fpcopy((digit_t*)&Montgomery_one, (s->phi[i]->Z)[0]);
+    }
 
     // Initialize constants
-    fpcopy((digit_t*)&Montgomery_one, A24plus[0]);
-    fp2add(A24plus, A24plus, C24);
+    fp2zero(s->c0);
+    fp2zero(s->c1);
+    if (party == ALICE) {
+        fpcopy((digit_t*)&Montgomery_one, s->c0[0]);
+        fp2add(s->c0, s->c0, s->c1);               // A24plus = 1, C24 = 2
+    } else {
+        fpcopy((digit_t*)&Montgomery_one, s->c1[0]);
+        fp2add(s->c1, s->c1, s->c1);
+        fp2copy(s->c1, s->c0);
+        fp2neg(s->c0);                             // A24minus = -2, A24plus = 2
+    }
 
     // Retrieve kernel point
-    LADDER3PT(XPA, XQA, XRA, (digit_t*)PrivateKeyA, ALICE, R, A);
-
-    // Traverse tree
-    index = 0;        
-    for (row = 1; row < MAX_Alice; row++) {
-        while (index < MAX_Alice-row) {
-            fp2copy(R->X, pts[npts]->X);
-            fp2copy(R->Z, pts[npts]->Z);
-            pts_index[npts++] = index;
-            m = strat_Alice[ii++];
-            xDBLe(R, R, A24plus, C24, (int)(2*m));
-            index += m;
+    LADDER3PT_KEYGEN_START(&s->ladder, XP, XQ, XR, (digit_t*)PrivateKey, party, A);
+}
+
+
+static void isog_start_agreement(isog_state_t* s, const unsigned int party, const unsigned char* PrivateKey, const unsigned char* PublicKey)
+{ // Starts the shared secret computation of a party with the public key of the other party
+    f2elm_t PKB[3], A, C = {0};
+
+    s->party = party;
+    s->keygen = 0;
+    s->stage = ISOG_LADDER;
+    s->key = PrivateKey;
+    s->max = (party == ALICE) ? MAX_Alice : MAX_Bob;
+    s->job.degree = (party == ALICE) ? 4 : 3;
+
+    // Initialize images of the basis of the other party
+    fp2_decode(PublicKey, PKB[0]);
+    fp2_decode(PublicKey + FP2_ENCODED_BYTES, PKB[1]);
+    fp2_decode(PublicKey + 2*FP2_ENCODED_BYTES, PKB[2]);
+
+    // Curve of the public key and constants
+#if defined(_PROJECTIVE_A_)
+    get_A_proj(PKB[0], PKB[1], PKB[2], A, C);
+    fp2add(C, C, C);                               // C = 2C
+    if (party == ALICE) {
+        fp2add(A, C, s->c0);                       // A24plus = A+2C
+        fp2add(C, C, s->c1);                       // C24 = 4C
+        LADDER3PT_PROJ_START(&s->ladder, PKB[0], PKB[1], PKB[2], (digit_t*)PrivateKey, party, s->c0, s->c1);
+    } else {
+        fp2add(A, C, s->c1);                       // A24plus = A+2C
+        fp2sub(A, C, s->c0);                       // A24minus = A-2C
+        fp2add(C, C, C);                           // C = 4C
+        LADDER3PT_PROJ_START(&s->ladder, PKB[0], PKB[1], PKB[2], (digit_t*)PrivateKey, party, s->c1, C);
+    }
+#else
+    get_A(PKB[0], PKB[1], PKB[2], A);
+    fpadd((digit_t*)&Montgomery_one, (digit_t*)&Montgomery_one, C[0]);
+    if (party == ALICE) {
+        fp2add(A, C, s->c0);                       // A24plus = A+2
+        fp2add(C, C, s->c1);                       // C24 = 4
+    } else {
+        fp2add(A, C, s->c1);                       // A24plus = A+2
+        fp2sub(A, C, s->c0);                       // A24minus = A-2
+    }
+    LADDER3PT_START(&s->ladder, PKB[0], PKB[1], PKB[2], (digit_t*)PrivateKey, party, A);
+#endif
+}
+
+
+static void isog_row_end(isog_state_t* s)
+{ // Next kernel point and stage, after the isogeny of a row
+    fp2copy(s->pts[s->npts-1]->X, s->R->X);
+    fp2copy(s->pts[s->npts-1]->Z, s->R->Z);
+    s->index = s->pts_index[s->npts-1];
+    s->npts -= 1;
+    s->row += 1;
+    if (s->row == s->max) {
+        s->stage = ISOG_LAST;
+    } else {
+        s->stage = (s->index < s->max - s->row) ? ISOG_CHAIN : ISOG_ROW;
+    }
+}
+
+
+static unsigned int isog_step(isog_state_t* s, isog_pool_t* pool)
+{ // Runs one stage of a key operation, with the evaluations of the rows on the pool if it is not NULL. Returns the number of
+  // steps it counts for, a step being one bit of the ladder, one doubling by 4 or tripling, or one isogeny evaluation
+    unsigned int i, n;
+    f2elm_t coeff[3], t0;
+
+    switch (s->stage) {
+    case ISOG_LADDER:                      // Retrieve kernel point
+        if (ladder_step(&s->ladder) == 0) return 1;
+        fp2copy(s->ladder.R->X, s->R->X);
+        fp2copy(s->ladder.R->Z, s->R->Z);
+        s->row = 1;
+        s->index = 0;
+        s->npts = 0;
+        s->run = 0;
+        s->ii = 0;
+        s->stage = ISOG_CHAIN;
+#if (OALICE_BITS % 2 == 1)
+        if (s->party == ALICE) {
+            fp2copy(s->R->X, s->S->X);
+            fp2copy(s->R->Z, s->S->Z);
+            s->run = (OALICE_BITS-1)/2;
+            s->stage = ISOG_TWO;
+        }
+#endif
+        return 1;
+
+#if (OALICE_BITS % 2 == 1)
+    case ISOG_TWO:                         // eA is odd, the first step is a 2-isogeny with kernel point [2^(eA-1)]R, the remaining ones are 4-isogenies
+        if (s->run > 0) {
+            xDBLe(s->S, s->S, s->c0, s->c1, 2);
+            s->run -= 1;
+            return 1;
+        }
+        get_2_isog(s->S, s->c0, s->c1);
+        if (s->keygen) {
+            eval_2_isog(s->phi[0], s->S);
+            eval_2_isog(s->phi[1], s->S);
+            eval_2_isog(s->phi[2], s->S);
+        }
+        eval_2_isog(s->R, s->S);
+        s->stage = ISOG_CHAIN;
+        return 1 + 3*s->keygen;
+#endif
+
+    case ISOG_CHAIN:                       // Traverse tree, one doubling by 4 or tripling of a run of the strategy
+        if (s->run == 0) {
+            copy_words((digit_t*)s->R, (digit_t*)s->pts[s->npts], 2*2*NWORDS_FIELD);
+            s->pts_index[s->npts++] = s->index;
+            s->run = (s->party == ALICE) ? strat_Alice[s->ii++] : strat_Bob[s->ii++];
+        }
+        if (s->party == ALICE) {
+            xDBLe(s->R, s->R, s->c0, s->c1, 2);
+        } else {
+            xTPL(s->R, s->R, s->c0, s->c1);
+        }
+        s->index += 1;
+        s->run -= 1;
+        if (s->run == 0 && s->index >= s->max - s->row) s->stage = ISOG_ROW;
+        return 1;
+
+    case ISOG_ROW:                         // Isogeny of a row, with the next kernel point first and the other points on the pool
+        if (s->party == ALICE) {
+            get_4_isog(s->R, s->c0, s->c1, s->job.coeff);
+        } else {
+            get_3_isog(s->R, s->c0, s->c1, s->job.coeff);
+        }
+        isog_sync(pool);                   // Evaluations of the previous row are complete
+
+        if (s->party == ALICE) {
+            eval_4_isog(s->pts[s->npts-1], s->job.coeff);
+        } else {
+            eval_3_isog(s->pts[s->npts-1], s->job.coeff);
+        }
+        for (i = 0; i < s->npts-1; i++) {
+            s->job.tasks[i] = s->pts[i];
+        }
+        if (s->keygen) {
+            s->job.tasks[s->npts-1] = s->phi[0];
+            s->job.tasks[s->npts] = s->phi[1];
+            s->job.tasks[s->npts+1] = s->phi[2];
         }
-        get_4_isog(R, A24plus, C24, coeff);        
+        n = s->npts + 3*s->keygen;
+        isog_run(pool, &s->job, n - 1);
+        isog_row_end(s);
+        return n;
+
+    case ISOG_LAST:
+        isog_sync(pool);
+        if (s->party == ALICE) {
+            get_4_isog(s->R, s->c0, s->c1, coeff);
+            if (s->keygen) {
+                eval_4_isog(s->phi[0], coeff);
+                eval_4_isog(s->phi[1], coeff);
+                eval_4_isog(s->phi[2], coeff);
+            } else {
+                fp2div2(s->c1, s->c1);
+                fp2sub(s->c0, s->c1, s->c0);
+                fp2div2(s->c1, s->c1);
+                j_inv_proj(s->c0, s->c1, s->jnum, s->jden);
+            }
+        } else {
+            get_3_isog(s->R, s->c0, s->c1, coeff);
+            if (s->keygen) {
+                eval_3_isog(s->phi[0], coeff);
+                eval_3_isog(s->phi[1], coeff);
+                eval_3_isog(s->phi[2], coeff);
+            } else {
+                fp2add(s->c1, s->c0, t0);          // t0 = 2A
+                fp2add(t0, t0, t0);                // t0 = 4A
+                fp2sub(s->c1, s->c0, s->c1);       // A24plus = 4C
+                j_inv_proj(t0, s->c1, s->jnum, s->jden);
+            }
+        }
+        s->stage = ISOG_DONE;
+        return 1 + 3*s->keygen;
+
+    default:
+        return 0;
+    }
+}
+
+
+static unsigned int isog_steps(isog_state_t* s, const unsigned int budget)
+{ // Runs steps of a key operation until budget is reached and returns the number of steps run, which may exceed budget by
+  // the last stage. The worker pool is taken from the first step of the traversal to the end of the slice, so that all its rows
+  // are complete on return.
+    isog_pool_t* pool = NULL;
+    unsigned int n, acquired = 0;
 
-        for (i = 0; i < npts; i++) {
-            eval_4_isog(pts[i], coeff);
+    for (n = 0; n < budget && s->stage != ISOG_DONE; ) {
+        if (acquired == 0 && s->stage >= ISOG_CHAIN) {
+            pool = isog_pool_acquire();
+            acquired = 1;
         }
-        eval_4_isog(phiP, coeff);
-        eval_4_isog(phiQ, coeff);
-        eval_4_isog(phiR, coeff);
-
-        fp2copy(pts[npts-1]->X, R->X); 
-        fp2copy(pts[npts-1]->Z, R->Z);
-        index = pts_index[npts-1];
-        npts -= 1;
+        n += isog_step(s, pool);
     }
+    isog_pool_release(pool);
+    return n;
+}
+
+
+static void isog_public_key(isog_state_t* s, unsigned char* PublicKey)
+{ // Public key from the images of the basis of the other party after a key generation
+    f2elm_t mask;
+
+    keygen_mask(s->key, (s->party == ALICE) ? SECRETKEY_A_BYTES : SECRETKEY_B_BYTES, mask);
+    inv_3_way_bingcd(s->phi[0]->Z, s->phi[1]->Z, s->phi[2]->Z, mask);
+    clear_words((void*)mask, 2*NWORDS_FIELD);
+    fp2mul_mont(s->phi[0]->X, s->phi[0]->Z, s->phi[0]->X);
+    fp2mul_mont(s->phi[1]->X, s->phi[1]->Z, s->phi[1]->X);
+    fp2mul_mont(s->phi[2]->X, s->phi[2]->Z, s->phi[2]->X);
 
-    get_4_isog(R, A24plus, C24, coeff); 
-    eval_4_isog(phiP, coeff);
-    eval_4_isog(phiQ, coeff);
-    eval_4_isog(phiR, coeff);
-
-    inv_3_way(phiP->Z, phiQ->Z, phiR->Z);
-    fp2mul_mont(phiP->X, phiP->Z, phiP->X);
-    fp2mul_mont(phiQ->X, phiQ->Z, phiQ->X);
-    fp2mul_mont(phiR->X, phiR->Z, phiR->X);
-                
-    // Format public key                   
-    fp2_encode(phiP->X, PublicKeyA);
-    fp2_encode(phiQ->X, PublicKeyA + FP2_ENCODED_BYTES);
-    fp2_encode(phiR->X, PublicKeyA + 2*FP2_ENCODED_BYTES);
+    // Format public key
+    fp2_encode(s->phi[0]->X, PublicKey);
+    fp2_encode(s->phi[1]->X, PublicKey + FP2_ENCODED_BYTES);
+    fp2_encode(s->phi[2]->X, PublicKey + 2*FP2_ENCODED_BYTES);
+}
+
+
+static void isog_shared_secret(isog_state_t* s, unsigned char* SharedSecret)
+{ // Shared secret from the j-invariant after a shared secret computation
+    fp2inv_mont(s->jden);                          // jinv = jnum/jden
+    fp2mul_mont(s->jnum, s->jden, s->jnum);
+    fp2_encode(s->jnum, SharedSecret);             // Format shared secret
+}
+
+
+int EphemeralKeyGeneration_A(const unsigned char* PrivateKeyA, unsigned char* PublicKeyA)
+{ // Alice's ephemeral public key generation
+  // Input:  a private key PrivateKeyA in the range [0, 2^eA - 1]. 
+  // Output: the public key PublicKeyA consisting of 3 elements in GF(p^2) which are encoded by removing leading 0 bytes.
+    isog_state_t s;
+
+    isog_start_keygen(&s, ALICE, PrivateKeyA);
+    isog_steps(&s, ISOG_ALL_STEPS);
+    isog_public_key(&s, PublicKeyA);
 
     return 0;
 }
@@ -151,66 +598,11 @@ int EphemeralKeyGeneration_B(const unsigned char* PrivateKeyB, unsigned char* Pu
 { // Bob's ephemeral public key generation
   // Input:  a private key PrivateKeyB in the range [0, 2^Floor(Log(2,oB)) - 1]. 
   // Output: the public key PublicKeyB consisting of 3 elements in GF(p^2) which are encoded by removing leading 0 bytes.
-    point_proj_t R, phiP = {0}, phiQ = {0}, phiR = {0}, pts[MAX_INT_POINTS_BOB];
-    f2elm_t XPB, XQB, XRB, coeff[3], A24plus = {0}, A24minus = {0}, A = {0};
-    unsigned int i, row, m, index = 0, pts_index[MAX_INT_POINTS_BOB], npts = 0, ii = 0;
+    isog_state_t s;
 
-    // Initialize basis points
-    init_basis((digit_t*)B_gen, XPB, XQB, XRB);
-    init_basis((digit_t*)A_gen, phiP->X, phiQ->X, phiR->X);
-    fpcopy((digit_t*)&Montgomery_one, (phiP->Z)[0]);
-    fpcopy((digit_t*)&Montgomery_one, (phiQ->Z)[0]);
-    fpcopy((digit_t*)&Montgomery_one, (phiR->Z)[0]);
-
-    // Initialize constants
-    fpcopy((digit_t*)&Montgomery_one, A24plus[0]);
-    fp2add(A24plus, A24plus, A24plus);
-    fp2copy(A24plus, A24minus);
-    fp2neg(A24minus);
-
-    // Retrieve kernel point
-    LADDER3PT(XPB, XQB, XRB, (digit_t*)PrivateKeyB, BOB, R, A);
-    
-    // Traverse tree
-    index = 0;  
-    for (row = 1; row < MAX_Bob; row++) {
-        while (index < MAX_Bob-row) {
-            fp2copy(R->X, pts[npts]->X);
-            fp2copy(R->Z, pts[npts]->Z);
-            pts_index[npts++] = index;
-            m = strat_Bob[ii++];
-            xTPLe(R, R, A24minus, A24plus, (int)m);
-            index += m;
-        } 
-        get_3_isog(R, A24minus, A24plus, coeff);
-
-        for (i = 0; i < npts; i++) {
-            eval_3_isog(pts[i], coeff);
-        }     
-        eval_3_isog(phiP, coeff);
-        eval_3_isog(phiQ, coeff);
-        eval_3_isog(phiR, coeff);
-
-        fp2copy(pts[npts-1]->X, R->X); 
-        fp2copy(pts[npts-1]->Z, R->Z);
-        index = pts_index[npts-1];
-        npts -= 1;
-    }
-    
-    get_3_isog(R, A24minus, A24plus, coeff);
-    eval_3_isog(phiP, coeff);
-    eval_3_isog(phiQ, coeff);
-    eval_3_isog(phiR, coeff);
-
-    inv_3_way(phiP->Z, phiQ->Z, phiR->Z);
-    fp2mul_mont(phiP->X, phiP->Z, phiP->X);
-    fp2mul_mont(phiQ->X, phiQ->Z, phiQ->X);
-    fp2mul_mont(phiR->X, phiR->Z, phiR->X);
-
-    // Format public key
-    fp2_encode(phiP->X, PublicKeyB);
-    fp2_encode(phiQ->X, PublicKeyB + FP2_ENCODED_BYTES);
-    fp2_encode(phiR->X, PublicKeyB + 2*FP2_ENCODED_BYTES);
+    isog_start_keygen(&s, BOB, PrivateKeyB);
+    isog_steps(&s, ISOG_ALL_STEPS);
+    isog_public_key(&s, PublicKeyB);
 
     return 0;
 }
@@ -222,54 +614,11 @@ int EphemeralSecretAgreement_A(const unsigned char* PrivateKeyA, const unsigned
   // Inputs: Alice's PrivateKeyA is an integer in the range [0, oA-1]. 
   //         Bob's PublicKeyB consists of 3 elements in GF(p^2) encoded by removing leading 0 bytes.
   // Output: a shared secret SharedSecretA that consists of one element in GF(p^2) encoded by removing leading 0 bytes.  
-    point_proj_t R, pts[MAX_INT_POINTS_ALICE];
-    f2elm_t coeff[3], PKB[3], jinv;
-    f2elm_t A24plus = {0}, C24 = {0}, A = {0};
-    unsigned int i, row, m, index = 0, pts_index[MAX_INT_POINTS_ALICE], npts = 0, ii = 0;
-      
-    // Initialize images of Bob's basis
-    fp2_decode(PublicKeyB, PKB[0]);
-    fp2_decode(PublicKeyB + FP2_ENCODED_BYTES, PKB[1]);
-    fp2_decode(PublicKeyB + 2*FP2_ENCODED_BYTES, PKB[2]);
+    isog_state_t s;
 
-    // Initialize constants
-    get_A(PKB[0], PKB[1], PKB[2], A); // TODO: Can return projective A?
-    fpadd((digit_t*)&Montgomery_one, (digit_t*)&Montgomery_one, C24[0]);
-    fp2add(A, C24, A24plus);
-    fpadd(C24[0], C24[0], C24[0]);
-
-    // Retrieve kernel point
-    LADDER3PT(PKB[0], PKB[1], PKB[2], (digit_t*)PrivateKeyA, ALICE, R, A);
-
-    // Traverse tree
-    index = 0;        
-    for (row = 1; row < MAX_Alice; row++) {
-        while (index < MAX_Alice-row) {
-            fp2copy(R->X, pts[npts]->X);
-            fp2copy(R->Z, pts[npts]->Z);
-            pts_index[npts++] = index;
-            m = strat_Alice[ii++];
-            xDBLe(R, R, A24plus, C24, (int)(2*m));
-            index += m;
-        }
-        get_4_isog(R, A24plus, C24, coeff);        
-
-        for (i = 0; i < npts; i++) {
-            eval_4_isog(pts[i], coeff);
-        }
-
-        fp2copy(pts[npts-1]->X, R->X); 
-        fp2copy(pts[npts-1]->Z, R->Z);
-        index = pts_index[npts-1];
-        npts -= 1;
-    }
-
-    get_4_isog(R, A24plus, C24, coeff); 
-    fp2div2(C24, C24);                                                
-    fp2sub(A24plus, C24, A24plus);                              
-    fp2div2(C24, C24);                               
-    j_inv(A24plus, C24, jinv);
-    fp2_encode(jinv, SharedSecretA);    // Format shared secret
+    isog_start_agreement(&s, ALICE, PrivateKeyA, PublicKeyB);
+    isog_steps(&s, ISOG_ALL_STEPS);
+    isog_shared_secret(&s, SharedSecretA);
 
     return 0;
 }
@@ -281,54 +630,11 @@ int EphemeralSecretAgreement_B(const unsigned char* PrivateKeyB, const unsigned
   // Inputs: Bob's PrivateKeyB is an integer in the range [0, 2^Floor(Log(2,oB)) - 1]. 
   //         Alice's PublicKeyA consists of 3 elements in GF(p^2) encoded by removing leading 0 bytes.
   // Output: a shared secret SharedSecretB that consists of one element in GF(p^2) encoded by removing leading 0 bytes.  
-    point_proj_t R, pts[MAX_INT_POINTS_BOB];
-    f2elm_t coeff[3], PKB[3], jinv;
-    f2elm_t A24plus = {0}, A24minus = {0}, A = {0};
-    unsigned int i, row, m, index = 0, pts_index[MAX_INT_POINTS_BOB], npts = 0, ii = 0;
-      
-    // Initialize images of Alice's basis
-    fp2_decode(PublicKeyA, PKB[0]);
-    fp2_decode(PublicKeyA + FP2_ENCODED_BYTES, PKB[1]);
-    fp2_decode(PublicKeyA + 2*FP2_ENCODED_BYTES, PKB[2]);
-
-    // Initialize constants
-    get_A(PKB[0], PKB[1], PKB[2], A); // TODO: Can return projective A?
-    fpadd((digit_t*)&Montgomery_one, (digit_t*)&Montgomery_one, A24minus[0]);
-    fp2add(A, A24minus, A24plus);
-    fp2sub(A, A24minus, A24minus);
-
-    // Retrieve kernel point
-    LADDER3PT(PKB[0], PKB[1], PKB[2], (digit_t*)PrivateKeyB, BOB, R, A);
-    
-    // Traverse tree
-    index = 0;  
-    for (row = 1; row < MAX_Bob; row++) {
-        while (index < MAX_Bob-row) {
-            fp2copy(R->X, pts[npts]->X);
-            fp2copy(R->Z, pts[npts]->Z);
-            pts_index[npts++] = index;
-            m = strat_Bob[ii++];
-            xTPLe(R, R, A24minus, A24plus, (int)m);
-            index += m;
-        }
-        get_3_isog(R, A24minus, A24plus, coeff);
+    isog_state_t s;
 
-        for (i = 0; i < npts; i++) {
-            eval_3_isog(pts[i], coeff);
-        } 
-
-        fp2copy(pts[npts-1]->X, R->X); 
-        fp2copy(pts[npts-1]->Z, R->Z);
-        index = pts_index[npts-1];
-        npts -= 1;
-    }
-     
-    get_3_isog(R, A24minus, A24plus, coeff);    
-    fp2add(A24plus, A24minus, A);                 
-    fp2add(A, A, A);
-    fp2sub(A24plus, A24minus, A24plus);                   
-    j_inv(A, A24plus, jinv);
-    fp2_encode(jinv, SharedSecretB);    // Format shared secret
+    isog_start_agreement(&s, BOB, PrivateKeyB, PublicKeyA);
+    isog_steps(&s, ISOG_ALL_STEPS);
+    isog_shared_secret(&s, SharedSecretB);
 
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,185 @@
+/********************************************************************************************
+* Supersingular Isogeny Key Encapsulation Library
+*
+* Abstract: supersingular isogeny key encapsulation (SIKE) protocol with resumable operations
+*********************************************************************************************/
+
+#include <string.h>
+#include "P751_internal.h"
+#include "sha3/fips202.h"
+
+
+/********************************************************************************************
+* A resumable operation runs the KEM functions of sike.c as a sequence of steps: the steps of
+* the key operations of sidh.c (a bit of the 3-point ladder, a doubling by 4 or tripling of
+* the tree traversal, or an isogeny evaluation), and the parts around them (a
+* normalization, a j-invariant with its inversion, the hashing). The state between two
+* steps is kept in sike_op_t, so the caller can run an operation in as many slices as it
+* wants. The number of steps of an operation depends on its type only. The ladder and the
+* traversal are the ones selected for the KEM by LADDER, FIXED_BASE, PROJECTIVE_A and
+* ISOG_THREADS; with ISOG_THREADS, the worker pool is only held within a slice.
+*********************************************************************************************/
+
+enum { OP_KEYPAIR, OP_ENC, OP_DEC };
+enum { OP_KEYGEN, OP_PUBLIC_KEY, OP_CURVE, OP_AGREEMENT, OP_SECRET, OP_DONE };  // Phases of an operation
+
+typedef struct {
+    unsigned int type;
+    unsigned int phase;
+    unsigned char *out0, *out1;            // Outputs and inputs of the KEM function, in its order
+    const unsigned char *in0, *in1;
+    isog_state_t isog;
+    unsigned char ephemeralsk[SECRETKEY_A_BYTES];
+    unsigned char jinvariant[FP2_ENCODED_BYTES];
+    unsigned char h[MSG_BYTES];
+    unsigned char c0[CRYPTO_PUBLICKEYBYTES];
+    unsigned char temp[CRYPTO_CIPHERTEXTBYTES+MSG_BYTES];
+} op_state_t;
+
+typedef char op_state_fits[(sizeof(op_state_t) <= sizeof(sike_op_t)) ? 1 : -1];    // CRYPTO_OPBYTES in api.h is large enough
+
+
+static void op_step(op_state_t* op)
+{ // Runs one step of an operation
+    const uint16_t G = 0;
+    const uint16_t H = 1;
+    const uint16_t P = 2;
+    unsigned int i;
+
+    switch (op->phase) {
+    case OP_PUBLIC_KEY:
+        if (op->type == OP_KEYPAIR) {          // pk, appended to sk
+            isog_public_key(&op->isog, op->out0);
+            memcpy(&op->out1[MSG_BYTES + SECRETKEY_B_BYTES], op->out0, CRYPTO_PUBLICKEYBYTES);
+            op->phase = OP_DONE;
+        } else if (op->type == OP_ENC) {       // ct, then the shared secret with pk
+            isog_public_key(&op->isog, op->out0);
+            op->phase = OP_CURVE;
+        } else {                               // Generate shared secret ss <- H(m||ct) or output ss <- H(s||ct)
+            isog_public_key(&op->isog, op->c0);
+            if (memcmp(op->c0, op->in0, CRYPTO_PUBLICKEYBYTES) != 0) {
+                memcpy(op->temp, op->in1, MSG_BYTES);
+            }
+            memcpy(&op->temp[MSG_BYTES], op->in0, CRYPTO_CIPHERTEXTBYTES);
+            cshake256_simple(op->out0, CRYPTO_BYTES, H, op->temp, CRYPTO_CIPHERTEXTBYTES+MSG_BYTES);
+            op->phase = OP_DONE;
+        }
+        break;
+
+    case OP_CURVE:                             // Shared secret with the public key pk (enc) or ct (dec)
+        if (op->type == OP_ENC) {
+            isog_start_agreement(&op->isog, ALICE, op->ephemeralsk, op->in0);
+        } else {
+            isog_start_agreement(&op->isog, BOB, op->in1 + MSG_BYTES, op->in0);
+        }
+        op->phase = OP_AGREEMENT;
+        break;
+
+    case OP_SECRET:
+        isog_shared_secret(&op->isog, op->jinvariant);
+        cshake256_simple(op->h, MSG_BYTES, P, op->jinvariant, FP2_ENCODED_BYTES);
+        if (op->type == OP_ENC) {
+            for (i = 0; i < MSG_BYTES; i++) op->out0[i + CRYPTO_PUBLICKEYBYTES] = op->temp[i] ^ op->h[i];
+
+            // Generate shared secret ss <- H(m||ct)
+            memcpy(&op->temp[MSG_BYTES], op->out0, CRYPTO_CIPHERTEXTBYTES);
+            cshake256_simple(op->out1, CRYPTO_BYTES, H, op->temp, CRYPTO_CIPHERTEXTBYTES+MSG_BYTES);
+            op->phase = OP_DONE;
+        } else {
+            for (i = 0; i < MSG_BYTES; i++) op->temp[i] = op->in0[i + CRYPTO_PUBLICKEYBYTES] ^ op->h[i];
+
+            // Generate ephemeralsk_ <- G(m||pk) mod oA, then c0_
+            memcpy(&op->temp[MSG_BYTES], &op->in1[MSG_BYTES + SECRETKEY_B_BYTES], CRYPTO_PUBLICKEYBYTES);
+            cshake256_simple(op->ephemeralsk, SECRETKEY_A_BYTES, G, op->temp, CRYPTO_PUBLICKEYBYTES+MSG_BYTES);
+            op->ephemeralsk[SECRETKEY_A_BYTES - 1] &= MASK_ALICE;
+            isog_start_keygen(&op->isog, ALICE, op->ephemeralsk);
+            op->phase = OP_KEYGEN;
+        }
+        break;
+
+    default:
+        break;
+    }
+}
+
+
+void sike_op_init_keypair(sike_op_t *op, unsigned char *pk, unsigned char *sk)
+{ // Starts crypto_kem_keypair(pk, sk)
+    op_state_t* state = (op_state_t*)op;
+
+    state->type = OP_KEYPAIR;
+    state->out0 = pk;
+    state->out1 = sk;
+    state->in0 = NULL;
+    state->in1 = NULL;
+
+    // Generate lower portion of secret key sk <- s||SK
+    randombytes(sk, MSG_BYTES);
+    random_mod_order_B(sk + MSG_BYTES);
+    isog_start_keygen(&state->isog, BOB, sk + MSG_BYTES);
+    state->phase = OP_KEYGEN;
+}
+
+
+void sike_op_init_enc(sike_op_t *op, unsigned char *ct, unsigned char *ss, const unsigned char *pk)
+{ // Starts crypto_kem_enc(ct, ss, pk)
+    const uint16_t G = 0;
+    op_state_t* state = (op_state_t*)op;
+
+    state->type = OP_ENC;
+    state->out0 = ct;
+    state->out1 = ss;
+    state->in0 = pk;
+    state->in1 = NULL;
+
+    // Generate ephemeralsk <- G(m||pk) mod oA
+    randombytes(state->temp, MSG_BYTES);
+    memcpy(&state->temp[MSG_BYTES], pk, CRYPTO_PUBLICKEYBYTES);
+    cshake256_simple(state->ephemeralsk, SECRETKEY_A_BYTES, G, state->temp, CRYPTO_PUBLICKEYBYTES+MSG_BYTES);
+    state->ephemeralsk[SECRETKEY_A_BYTES - 1] &= MASK_ALICE;
+    isog_start_keygen(&state->isog, ALICE, state->ephemeralsk);
+    state->phase = OP_KEYGEN;
+}
+
+
+void sike_op_init_dec(sike_op_t *op, unsigned char *ss, const unsigned char *ct, const unsigned char *sk)
+{ // Starts crypto_kem_dec(ss, ct, sk)
+    op_state_t* state = (op_state_t*)op;
+
+    state->type = OP_DEC;
+    state->out0 = ss;
+    state->out1 = NULL;
+    state->in0 = ct;
+    state->in1 = sk;
+    state->phase = OP_CURVE;
+}
+
+
+int sike_op_step(sike_op_t *op, const unsigned int budget)
+{ // Runs up to budget steps of an operation, returns 1 once it is complete and 0 otherwise
+    op_state_t* state = (op_state_t*)op;
+    unsigned int n;
+
+    for (n = 0; n < budget && state->phase != OP_DONE; ) {
+        if (state->phase == OP_KEYGEN || state->phase == OP_AGREEMENT) {
+            n += isog_steps(&state->isog, budget - n);
+            if (state->isog.stage == ISOG_DONE) {
+                state->phase = (state->phase == OP_KEYGEN) ? OP_PUBLIC_KEY : OP_SECRET;
+            }
+        } else {
+            op_step(state);
+            n++;
+        }
+    }
+    return (state->phase == OP_DONE) ? 1 : 0;
+}
+
+
+int sike_op_done(sike_op_t *op)
+{ // Ends an operation and clears its state. Returns 0 if it was complete and -1 otherwise
+    op_state_t* state = (op_state_t*)op;
+    int result = (state->phase == OP_DONE) ? 0 : -1;
+
+    clear_words((void*)op, sizeof(sike_op_t)/sizeof(digit_t));
+    return result;
+}
@@ -0,0 +1,76 @@
+/********************************************************************************************
+* Supersingular Isogeny Key Encapsulation Library
+*
+* Abstract: strategies for the isogeny tree traversal in p751 = 2^372*3^239-1
+*           Generated by tools/gen_strategy.c, do not edit.
+*
+* Costs in multiplications in GF(p): xDBL 16, xTPL 22, get_4_isog 8, eval_4_isog 16,
+* get_3_isog 12, eval_3_isog 10. Simulated key generation plus shared secret:
+* 2 cores: Alice 57184 (sequential strategy 58080), Bob 51660 (53096)
+* 3 cores: Alice 51496 (sequential strategy 53224), Bob 46194 (48856)
+* 4 cores: Alice 49200 (sequential strategy 51160), Bob 43564 (46962)
+*********************************************************************************************/
+
+#if (_ISOG_THREADS_ == 2)
+const unsigned int strat_Alice[MAX_Alice-1] = { 
+59, 41, 30, 21, 15, 10, 6, 3, 2, 1, 3, 2, 1, 1, 1, 4, 3, 2, 1, 1, 1, 1, 1, 1, 5, 
+4, 3, 2, 1, 1, 1, 1, 1, 1, 2, 1, 1, 1, 6, 5, 4, 3, 2, 1, 1, 1, 1, 1, 1, 2, 1, 1, 
+1, 2, 1, 1, 1, 1, 9, 6, 5, 4, 3, 2, 1, 1, 1, 1, 1, 1, 2, 1, 1, 1, 2, 1, 1, 1, 1, 
+3, 2, 1, 1, 1, 1, 1, 1, 11, 9, 6, 5, 4, 3, 2, 1, 1, 1, 1, 1, 1, 2, 1, 1, 1, 2, 1, 
+1, 1, 1, 3, 2, 1, 1, 1, 1, 1, 1, 3, 2, 2, 1, 1, 1, 1, 1, 1, 1, 15, 13, 9, 7, 5, 
+4, 3, 2, 1, 1, 1, 1, 1, 1, 2, 1, 1, 1, 2, 2, 1, 1, 1, 1, 3, 2, 1, 1, 1, 1, 1, 1, 
+3, 3, 2, 2, 1, 1, 1, 1, 1, 1, 1, 1, 4, 3, 2, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1 };
+
+const unsigned int strat_Bob[MAX_Bob-1] = { 
+67, 47, 36, 28, 21, 15, 9, 7, 5, 3, 2, 1, 2, 2, 1, 1, 3, 2, 1, 1, 1, 1, 3, 2, 2, 
+1, 1, 1, 1, 1, 4, 4, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 5, 4, 4, 3, 2, 2, 1, 1, 
+1, 1, 1, 1, 1, 1, 1, 1, 2, 1, 1, 1, 7, 5, 4, 4, 3, 2, 2, 1, 1, 1, 1, 1, 1, 1, 1, 
+1, 1, 2, 1, 1, 1, 2, 2, 1, 1, 1, 1, 10, 7, 5, 4, 3, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 
+1, 2, 1, 1, 1, 2, 2, 1, 1, 1, 1, 3, 2, 2, 1, 1, 1, 1, 1, 1, 12, 9, 7, 5, 4, 3, 3, 
+2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 2, 1, 1, 1, 2, 2, 1, 1, 1, 1, 2, 2, 2, 1, 1, 1, 1, 
+1, 3, 2, 2, 2, 1, 1, 1, 1, 1, 1, 1, 17, 14, 10, 7, 5, 4, 3, 3, 2, 1, 1, 1, 1, 1, 
+1, 1, 1, 1, 2, 1, 1, 1, 2, 2, 1, 1, 1, 1, 3, 2, 2, 1, 1, 1, 1, 1, 1, 4, 3, 2, 2, 
+1, 1, 1, 1, 1, 1, 1, 1, 1, 4, 3, 3, 2, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1 };
+#elif (_ISOG_THREADS_ == 3)
+const unsigned int strat_Alice[MAX_Alice-1] = { 
+57, 42, 30, 22, 15, 10, 5, 4, 3, 2, 1, 2, 2, 1, 1, 3, 3, 3, 2, 1, 1, 1, 1, 1, 5, 
+3, 3, 3, 2, 1, 1, 1, 1, 1, 2, 1, 1, 1, 7, 5, 3, 3, 3, 2, 1, 1, 1, 1, 1, 2, 1, 1, 
+1, 2, 2, 1, 1, 1, 1, 9, 7, 4, 3, 3, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 2, 2, 1, 1, 1, 
+1, 2, 2, 2, 1, 1, 1, 1, 1, 11, 9, 7, 5, 3, 3, 3, 2, 1, 1, 1, 1, 1, 2, 1, 1, 1, 2, 
+2, 1, 1, 1, 1, 2, 2, 2, 1, 1, 1, 1, 1, 2, 2, 2, 2, 1, 1, 1, 1, 1, 1, 15, 11, 9, 
+7, 5, 3, 3, 3, 2, 1, 1, 1, 1, 1, 2, 1, 1, 1, 2, 2, 1, 1, 1, 1, 2, 2, 2, 1, 1, 1, 
+1, 1, 2, 2, 2, 2, 1, 1, 1, 1, 1, 1, 4, 2, 2, 2, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1 };
+
+const unsigned int strat_Bob[MAX_Bob-1] = { 
+57, 46, 38, 30, 23, 16, 11, 8, 5, 4, 3, 2, 1, 2, 2, 1, 1, 3, 2, 2, 1, 1, 1, 1, 3, 
+3, 2, 2, 1, 1, 1, 1, 1, 1, 4, 3, 3, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 6, 5, 3, 
+3, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 7, 6, 5, 3, 3, 3, 2, 1, 
+1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 2, 1, 1, 1, 1, 1, 8, 7, 6, 5, 3, 3, 
+3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 2, 1, 1, 1, 1, 1, 1, 2, 1, 
+1, 1, 1, 1, 9, 8, 7, 6, 4, 3, 3, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 
+1, 2, 1, 1, 1, 1, 1, 1, 2, 1, 1, 1, 1, 1, 1, 1, 2, 1, 1, 1, 1, 1, 10, 9, 8, 7, 6, 
+5, 3, 3, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 2, 1, 1, 1, 1, 1, 
+1, 2, 1, 1, 1, 1, 1, 1, 1, 2, 1, 1, 1, 1, 1, 1, 1, 1, 2, 1, 1, 1, 1, 1 };
+#elif (_ISOG_THREADS_ == 4)
+const unsigned int strat_Alice[MAX_Alice-1] = { 
+57, 42, 30, 22, 15, 10, 6, 3, 2, 1, 3, 2, 1, 1, 1, 4, 3, 2, 1, 1, 1, 1, 1, 1, 5, 
+4, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 7, 5, 4, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 
+1, 2, 1, 1, 1, 1, 1, 8, 7, 5, 4, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 2, 1, 1, 1, 
+1, 1, 2, 1, 1, 1, 1, 1, 1, 11, 9, 7, 5, 4, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 2, 
+1, 1, 1, 1, 1, 2, 2, 1, 1, 1, 1, 1, 1, 2, 2, 2, 1, 1, 1, 1, 1, 1, 1, 15, 11, 9, 
+7, 5, 4, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 2, 1, 1, 1, 1, 1, 2, 2, 1, 1, 1, 1, 
+1, 1, 2, 2, 2, 1, 1, 1, 1, 1, 1, 1, 4, 2, 2, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1 };
+
+const unsigned int strat_Bob[MAX_Bob-1] = { 
+57, 46, 38, 30, 23, 17, 11, 8, 5, 3, 2, 1, 2, 2, 1, 1, 3, 2, 2, 1, 1, 1, 1, 3, 3, 
+2, 2, 1, 1, 1, 1, 1, 1, 5, 4, 3, 2, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 6, 5, 4, 
+3, 2, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 7, 6, 5, 4, 3, 2, 2, 1, 
+1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 8, 7, 6, 5, 4, 3, 
+2, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 
+1, 1, 1, 1, 9, 8, 7, 6, 5, 3, 3, 2, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 
+1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 10, 9, 8, 7, 6, 
+5, 4, 3, 2, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 
+1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1 };
+#else
+    #error -- "No strategy for _ISOG_THREADS_ cores"
+#endif
@@ -66,6 +66,11 @@ const uint64_t Border_div3[NWORDS_ORDER]         = { 0xEDCD718A828384F9, 0x733B3
 
 
 // Fixed parameters for isogeny tree computation
+#if defined(_STRAT_TUNED_)
+#include "strat_tuned.h"                        // Strategies for the costs measured by "make tune"
+#elif defined(_ISOG_THREADS_)
+#include "strat_parallel.c"                     // Strategies for the traversal on _ISOG_THREADS_ cores
+#else
 const unsigned int strat_Alice[MAX_Alice-1] = { 
 80, 48, 27, 15, 8, 4, 2, 1, 1, 2, 1, 1, 4, 2, 1, 1, 2, 1, 1, 7, 4, 2, 1, 1, 2, 1, 
 1, 3, 2, 1, 1, 1, 1, 12, 7, 4, 2, 1, 1, 2, 1, 1, 3, 2, 1, 1, 1, 1, 5, 3, 2, 1, 1, 
@@ -85,6 +90,7 @@ const unsigned int strat_Bob[MAX_Bob-1] = {
 15, 8, 4, 2, 1, 1, 2, 1, 1, 4, 2, 1, 1, 2, 1, 1, 7, 4, 2, 1, 1, 2, 1, 1, 3, 2, 1, 
 1, 1, 1, 21, 12, 8, 4, 2, 1, 1, 2, 1, 1, 4, 2, 1, 1, 2, 1, 1, 5, 3, 2, 1, 1, 1, 1, 
 2, 1, 1, 1, 9, 5, 3, 2, 1, 1, 1, 1, 2, 1, 1, 1, 4, 2, 1, 1, 1, 2, 1, 1 };
+#endif
 
 // Setting up macro defines and including GF(p), GF(p^2), curve, isogeny and kex functions
 
@@ -96,10 +102,15 @@ const unsigned int strat_Bob[MAX_Bob-1] = {
 #define fpdiv2                  fpdiv2_751
 #define fpcorrection            fpcorrection751
 #define fpmul_mont              fpmul751_mont
+#define fpmul_mont_x2           fpmul751_mont_x2
 #define fpsqr_mont              fpsqr751_mont
 #define fpinv_mont              fpinv751_mont
 #define fpinv_chain_mont        fpinv751_chain_mont
+#define fpexp_mont              fpexp751_mont
+#define fpsqrt_mont             fpsqrt751_mont
+#define fp_legendre             fp_legendre751
 #define fpinv_mont_bingcd       fpinv751_mont_bingcd
+#define fpinv_mont_safegcd      fpinv751_mont_safegcd
 #define fp2copy                 fp2copy751
 #define fp2zero                 fp2zero751
 #define fp2add                  fp2add751
@@ -108,9 +119,15 @@ const unsigned int strat_Bob[MAX_Bob-1] = {
 #define fp2div2                 fp2div2_751
 #define fp2correction           fp2correction751
 #define fp2mul_mont             fp2mul751_mont
+#define fp2mul_mont_asm         fp2mul751_mont_asm
+#define fp2mul_mont_x2          fp2mul751_mont_x2
 #define fp2sqr_mont             fp2sqr751_mont
+#define fp2sqr_mont_asm         fp2sqr751_mont_asm
 #define fp2inv_mont             fp2inv751_mont
 #define fp2inv_mont_bingcd      fp2inv751_mont_bingcd
+#define fp2exp_mont             fp2exp751_mont
+#define fp2_is_square           fp2_is_square751
+#define fp2sqrt                 fp2sqrt751
 #define fpequal_non_constant_time  fpequal751_non_constant_time
 #define mp_add_asm              mp_add751_asm
 #define mp_addx2_asm            mp_add751x2_asm
@@ -119,4 +136,7 @@ const unsigned int strat_Bob[MAX_Bob-1] = {
 #include "fpx.c"
 #include "ec_isogeny.c"
 #include "sidh.c"
-#include "sike.c"
\ No newline at end of file
+#include "sidh_compressed.c"
+#include "sike.c"
+#include "sike_compressed.c"
+#include "sike_step.c"
\ No newline at end of file
@@ -0,0 +1,273 @@
+/********************************************************************************************
+* Supersingular Isogeny Key Encapsulation Library
+*
+* Abstract: generator of the addition chain for the field inversion exponent (p-3)/4,
+*           for a SIDH prime p = 2^eA*3^eB-1.
+*
+* Usage:    gen_chain eA eB [ratio] > fpinv_chain.c
+*           ratio is the cost of a squaring relative to a multiplication (default 0.8).
+*
+* The chain evaluates (p-3)/4 = 3^eB*2^(eA-2)-1 from left to right with windows of two kinds:
+* odd digits d <= D read from a table of a^3, a^5, ..., a^D, and runs of k ones read from
+* precomputed powers a^(2^k-1), k = b, 2b, 4b, ... with 2^b-1 <= D. The low eA-2 bits of the
+* exponent are all ones, so the second kind replaces most of the window multiplications of a
+* plain sliding window. For every D and every number of doublings of the runs, the windows
+* are chosen by dynamic programming, and the cheapest chain is emitted as straight-line C.
+*********************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+
+#define MAX_BITS          2048
+#define MAX_DIGIT         127                   // Largest odd table digit, 62 table entries
+#define MAX_DIGIT_BITS    7
+#define MAX_DOUBLINGS     6
+
+typedef struct {
+    int kind;                                   // 0: odd digit from the table, 1: run of ones
+    int value;                                  // Digit, or length of the run
+    int pos;                                    // Position of the lowest bit of the window
+} window_t;
+
+typedef struct {
+    int D, b, doublings;                        // Table digits up to D, runs of b*2^j ones for j <= doublings
+    int nwin;
+    window_t win[MAX_BITS];
+    int table, runs;                            // Table entries and run powers that are actually used
+    int sqr, mul;
+    double cost;
+} chain_t;
+
+static unsigned char bits[MAX_BITS];
+static int nbits;
+
+
+static void exponent_setup(int eA, int eB)
+{ // bits = (p-3)/4 = 3^eB*2^(eA-2) - 1, least significant bit first
+    unsigned int x[MAX_BITS/32] = {0}, carry;
+    int i, j, n = MAX_BITS/32;
+    unsigned long long t;
+
+    x[0] = 1;
+    for (i = 0; i < eB; i++) {                  // x = 3^eB
+        carry = 0;
+        for (j = 0; j < n; j++) {
+            t = 3ULL*x[j] + carry;
+            x[j] = (unsigned int)t;
+            carry = (unsigned int)(t >> 32);
+        }
+    }
+    for (j = 0; x[j] == 0; j++) x[j] = 0xFFFFFFFF;   // x = 3^eB - 1
+    x[j] -= 1;
+
+    memset(bits, 0, sizeof(bits));              // bits = (3^eB - 1)*2^(eA-2) + 2^(eA-2) - 1
+    for (i = 0; i < eA-2; i++) bits[i] = 1;
+    for (i = 0; i < n*32 && i + eA-2 < MAX_BITS; i++) {
+        bits[i + eA-2] = (x[i/32] >> (i%32)) & 1;
+    }
+    for (nbits = MAX_BITS; nbits > 0 && bits[nbits-1] == 0; nbits--);
+}
+
+
+static void chain_plan(chain_t* c, double ratio)
+{ // Minimum number of windows for the table digits up to c->D and the runs of c->b*2^j ones, j <= c->doublings
+    static int g[MAX_BITS+1], choice[MAX_BITS+1], run[MAX_BITS+1];
+    int i, j, L, v, maxdigit = 1, maxrun = 0;
+
+    g[0] = 0; run[0] = 0;
+    for (i = 1; i <= nbits; i++) {
+        run[i] = bits[i-1] ? run[i-1] + 1 : 0;
+        if (bits[i-1] == 0) {                   // Zero bit, squaring only
+            g[i] = g[i-1]; choice[i] = 0;
+            continue;
+        }
+        g[i] = MAX_BITS+1;
+        for (L = 1, v = 0; L <= MAX_DIGIT_BITS + 1 && L <= i; L++) {
+            v |= bits[i-L] << (L-1);            // v = bits[i-L..i-1]
+            if (v > c->D) break;
+            if (bits[i-L] == 1 && 1 + g[i-L] <= g[i]) {
+                g[i] = 1 + g[i-L]; choice[i] = L;
+            }
+        }
+        for (j = 0; j <= c->doublings && c->b > 0; j++) {
+            L = c->b << j;
+            if (L <= run[i] && 1 + g[i-L] < g[i]) {
+                g[i] = 1 + g[i-L]; choice[i] = -L;
+            }
+        }
+    }
+
+    c->nwin = 0;                                // Windows from the most significant one
+    for (i = nbits; i > 0; ) {
+        if (choice[i] == 0) {
+            i--;
+        } else if (choice[i] > 0) {
+            L = choice[i];
+            for (j = 0, v = 0; j < L; j++) v |= bits[i-L+j] << j;
+            c->win[c->nwin].kind = 0; c->win[c->nwin].value = v; c->win[c->nwin].pos = i-L;
+            if (v > maxdigit) maxdigit = v;
+            c->nwin++; i -= L;
+        } else {
+            L = -choice[i];
+            c->win[c->nwin].kind = 1; c->win[c->nwin].value = L; c->win[c->nwin].pos = i-L;
+            if (L > maxrun) maxrun = L;
+            c->nwin++; i -= L;
+        }
+    }
+
+    if (maxrun > 0 && (1 << c->b) - 1 > maxdigit) maxdigit = (1 << c->b) - 1;
+    c->table = (maxdigit - 1)/2;
+    c->runs = 0;
+    while (maxrun > (c->b << c->runs)) c->runs++;
+
+    c->mul = c->table + c->nwin - 1;
+    c->sqr = (c->table > 0) + c->win[0].pos;
+    for (j = 0; j < c->runs; j++) {             // a^(2^(2k)-1) = (a^(2^k-1))^(2^k) * a^(2^k-1)
+        c->sqr += c->b << j;
+        c->mul += 1;
+    }
+    c->cost = c->mul + ratio*c->sqr;
+}
+
+
+static void chain_search(chain_t* best, double ratio, int max_doublings)
+{ // Cheapest chain over all table sizes and numbers of run doublings
+    static chain_t c;
+    int D, d;
+
+    best->cost = -1;
+    for (D = 1; D <= MAX_DIGIT; D += 2) {
+        for (d = 0; d <= max_doublings; d++) {
+            c.D = D;
+            c.b = (int)log2(D + 1);
+            c.doublings = d;
+            chain_plan(&c, ratio);
+            if (best->cost < 0 || c.cost < best->cost || (c.cost == best->cost && c.sqr < best->sqr)) {
+                *best = c;
+            }
+        }
+    }
+}
+
+
+static const char* operand(const chain_t* c, const window_t* w, char* buf)
+{ // Name of the precomputed value for a window
+    int v = (w->kind == 0) ? w->value : (1 << c->b) - 1;
+
+    if (w->kind == 1 && w->value > c->b) {
+        int j = 0;
+        while ((c->b << j) < w->value) j++;
+        sprintf(buf, "u[%d]", j-1);
+    } else if (v == 1) {
+        sprintf(buf, "a");
+    } else {
+        sprintf(buf, "t[%d]", (v - 3)/2);
+    }
+    return buf;
+}
+
+
+static void emit_squarings(const char* x, int n)
+{
+    if (n == 1) {
+        printf("    fpsqr_mont(%s, %s);\n", x, x);
+    } else if (n > 1) {
+        printf("    for (i = 0; i < %d; i++) fpsqr_mont(%s, %s);\n", n, x, x);
+    }
+}
+
+
+static void emit(const chain_t* c, int eA, int eB, int pbits, const chain_t* base)
+{
+    char name[32], name2[32];
+    int i, j;
+    window_t run_base;
+
+    printf("/********************************************************************************************\n");
+    printf("* Supersingular Isogeny Key Encapsulation Library\n");
+    printf("*\n");
+    printf("* Abstract: addition chain for the field inversion in GF(p%d), p%d = 2^%d*3^%d-1\n", pbits, pbits, eA, eB);
+    printf("*           Generated by tools/gen_chain.c, do not edit.\n");
+    printf("*\n");
+    printf("* Chain for (p%d-3)/4: %d squarings and %d multiplications.\n", pbits, c->sqr, c->mul);
+    printf("* Sliding window only: %d squarings and %d multiplications.\n", base->sqr, base->mul);
+    printf("*********************************************************************************************/\n\n\n");
+
+    printf("void fpinv_chain_mont(felm_t a)\n");
+    printf("{ // Chain to compute a^(p%d-3)/4 using Montgomery arithmetic\n", pbits);
+    printf("    felm_t tt");
+    if (c->table > 0) printf(", t[%d]", c->table);
+    if (c->runs > 0) printf(", u[%d]", c->runs);
+    printf(";\n");
+    printf("    unsigned int i;\n\n");
+
+    if (c->table > 0) {
+        printf("    // Precomputed table a^3, a^5, ..., a^%d\n", 2*c->table + 1);
+        printf("    fpsqr_mont(a, tt);\n");
+        printf("    fpmul_mont(a, tt, t[0]);\n");
+        if (c->table == 2) {
+            printf("    fpmul_mont(t[0], tt, t[1]);\n");
+        } else if (c->table > 2) {
+            printf("    for (i = 0; i < %d; i++) fpmul_mont(t[i], tt, t[i+1]);\n", c->table - 1);
+        }
+        printf("\n");
+    }
+    if (c->runs > 0) {
+        printf("    // Powers a^(2^k-1) for k =");
+        for (j = 1; j <= c->runs; j++) printf(" %d%s", c->b << j, j < c->runs ? "," : "\n");
+        run_base.kind = 1; run_base.value = c->b; run_base.pos = 0;
+        for (j = 0; j < c->runs; j++) {
+            if (j == 0) operand(c, &run_base, name); else sprintf(name, "u[%d]", j-1);
+            sprintf(name2, "u[%d]", j);
+            printf("    fpcopy(%s, %s);\n", name, name2);
+            emit_squarings(name2, c->b << j);
+            printf("    fpmul_mont(%s, %s, %s);\n", name, name2, name2);
+        }
+        printf("\n");
+    }
+
+    printf("    // Windows from the most significant bit\n");
+    printf("    fpcopy(%s, tt);\n", operand(c, &c->win[0], name));
+    for (i = 1; i < c->nwin; i++) {
+        emit_squarings("tt", c->win[i-1].pos - c->win[i].pos);
+        printf("    fpmul_mont(%s, tt, tt);\n", operand(c, &c->win[i], name));
+    }
+    emit_squarings("tt", c->win[c->nwin-1].pos);
+    printf("    fpcopy(tt, a);\n");
+    printf("}\n");
+}
+
+
+int main(int argc, char** argv)
+{
+    static chain_t best, base;
+    double ratio = 0.8;
+    int eA, eB, pbits;
+
+    if (argc < 3 || argc > 4) {
+        fprintf(stderr, "Usage: %s eA eB [ratio]\n", argv[0]);
+        return 1;
+    }
+    eA = atoi(argv[1]);
+    eB = atoi(argv[2]);
+    if (argc == 4) ratio = atof(argv[3]);
+    if (eA < 2 || eB < 1 || eA + 2*eB > MAX_BITS - 8) {
+        fprintf(stderr, "Unsupported exponents eA = %d, eB = %d\n", eA, eB);
+        return 1;
+    }
+
+    exponent_setup(eA, eB);
+    pbits = nbits + 2;                          // p = 4*((p-3)/4) + 3
+
+    chain_search(&base, ratio, 0);
+    chain_search(&best, ratio, MAX_DOUBLINGS);
+    emit(&best, eA, eB, pbits, &base);
+
+    fprintf(stderr, "p%d: chain for (p-3)/4 with %d squarings and %d multiplications (table a^3..a^%d, %d run powers); "
+                    "sliding window only: %d squarings and %d multiplications\n",
+                    pbits, best.sqr, best.mul, 2*best.table + 1, best.runs, base.sqr, base.mul);
+    return 0;
+}
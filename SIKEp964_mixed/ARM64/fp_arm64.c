@@ -922,6 +922,20 @@ void mp_mul(const digit_t* a, const digit_t* b, digit_t* c, const unsigned int n
 	fpadd1024_arm64(&c[8], rplus, &c[8]);
 }
 
+void mp_mul_x2(const digit_t* a0, const digit_t* b0, digit_t* c0, const digit_t* a1, const digit_t* b1, digit_t* c1, const unsigned int nwords)
+{ // Two independent multiprecision multiplications, c0 = a0*b0 and c1 = a1*b1, where all operands have nwords.
+  // a0*b0 runs on ASIMD and a1*b1 on the general registers, interleaved in one kernel.
+  // c0 and c1 must not overlap any of the inputs.
+    UNREFERENCED_PARAMETER(nwords);
+    mul964_x2_asm(a0, b0, c0, a1, b1, c1);
+}
+
+void mp_sqr(const digit_t* a, digit_t* c, const unsigned int nwords)
+{ // Multiprecision squaring, c = a^2, where lng(a) = nwords.
+  // There is no mixed ASIMD/GPR squaring kernel for this prime, the multiplication kernels square.
+    mp_mul(a, a, c, nwords);
+}
+
 void rdc_mont(const digit_t *ma, digit_t *mc)
 { // Optimized Montgomery reduction using comba and exploiting the special form of the prime p964.
   // mc = ma*mb*R^-1 mod p964, where ma,mb,mc in [0, p964-1] and R = 2^1024.
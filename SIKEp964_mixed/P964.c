@@ -86,8 +86,19 @@ const uint64_t Montgomery_one[NWORDS64_FIELD] = {0x1E67F3F78730D81B, 0x000000000
                                                  0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x3E738FC000000000,
                                                  0x0A21FE854AE027A8, 0x853FB7B621CC75C3, 0xDB8515C38E354F0C, 0x6232C1D569A850B5,
                                                  0x377C1534E2EF4915, 0x964EE9BA62138CAD, 0xE011B4007E0E88AA, 0x0000000000000004};
+// Value (2^512)^2 mod 3^301
+const uint64_t Montgomery_Rprime[NWORDS64_ORDER] = {0x682210082DE5B5A7, 0x349D82C2E02FDB77, 0x088997F898AB14FF, 0xFDC086752BAD54D4,
+                                                    0x657FFC0131C38A8A, 0x270B09764892C92F, 0x85F5F42E39E93D5C, 0x00000000192EF3BA};
+// Value -(3^301)^-1 mod 2^512
+const uint64_t Montgomery_rprime[NWORDS64_ORDER] = {0x670F41F35399B725, 0xBE3AB52E86AF08CB, 0xB93A82A58FDE7C85, 0xB00AA89D68FD0BEF,
+                                                    0xCA5383924FD28818, 0x0626F42199724A9F, 0x1C85615AECCDA575, 0x86B2551566ED723E};
 
 // Fixed parameters for isogeny tree computation
+#if defined(_STRAT_TUNED_)
+#include "strat_tuned.h"                        // Strategies for the costs measured by "make tune"
+#elif defined(_ISOG_THREADS_)
+#include "strat_parallel.c"                     // Strategies for the traversal on _ISOG_THREADS_ cores
+#else
 const unsigned int strat_Alice[MAX_Alice] = {
 0, 1, 1, 2, 2, 2, 3, 4, 4, 4, 4, 5, 5, 6, 7, 8, 8, 9, 9, 9, 9,
 9, 9, 9, 12, 11, 12, 12, 13, 14, 15, 16, 16, 16, 16, 16, 16, 17, 17, 18, 18, 17,
@@ -120,6 +131,7 @@ const unsigned int strat_Bob[MAX_Bob] = {
 112, 112, 110, 111, 112, 113, 114, 115, 114, 114, 114, 115, 114, 115, 114, 115,
 115, 116, 115, 115, 117, 116, 115, 122, 117, 116, 116, 115, 122, 117, 116, 122,
 115, 122, 117, 116, 122, 115, 122, 117, 116, 122, 115};
+#endif
 
 // Setting up macro defines and including GF(p), GF(p^2), curve, isogeny and kex functions
 
@@ -131,10 +143,15 @@ const unsigned int strat_Bob[MAX_Bob] = {
 #define fpdiv2 fpdiv2_964
 #define fpcorrection fpcorrection964
 #define fpmul_mont fpmul964_mont
+#define fpmul_mont_x2 fpmul964_mont_x2
 #define fpsqr_mont fpsqr964_mont
 #define fpinv_mont fpinv964_mont
 #define fpinv_chain_mont fpinv964_chain_mont
+#define fpexp_mont fpexp964_mont
+#define fpsqrt_mont fpsqrt964_mont
+#define fp_legendre fp_legendre964
 #define fpinv_mont_bingcd fpinv964_mont_bingcd
+#define fpinv_mont_safegcd fpinv964_mont_safegcd
 #define fp2copy fp2copy964
 #define fp2zero fp2zero964
 #define fp2add fp2add964
@@ -143,9 +160,15 @@ const unsigned int strat_Bob[MAX_Bob] = {
 #define fp2div2 fp2div2_964
 #define fp2correction fp2correction964
 #define fp2mul_mont fp2mul964_mont
+#define fp2mul_mont_asm fp2mul964_mont_asm
+#define fp2mul_mont_x2 fp2mul964_mont_x2
 #define fp2sqr_mont fp2sqr964_mont
+#define fp2sqr_mont_asm fp2sqr964_mont_asm
 #define fp2inv_mont fp2inv964_mont
 #define fp2inv_mont_bingcd fp2inv964_mont_bingcd
+#define fp2exp_mont fp2exp964_mont
+#define fp2_is_square fp2_is_square964
+#define fp2sqrt fp2sqrt964
 #define fpequal_non_constant_time fpequal964_non_constant_time
 #define mp_add_asm mp_add964_asm
 #define mp_addx2_asm mp_add964x2_asm
@@ -154,4 +177,7 @@ const unsigned int strat_Bob[MAX_Bob] = {
 #include "fpx.c"
 #include "ec_isogeny.c"
 #include "sidh.c"
+#include "sidh_compressed.c"
 #include "sike.c"
+#include "sike_compressed.c"
+#include "sike_step.c"
@@ -12,6 +12,17 @@
 #include <stddef.h>
 
 
+// Definition of operating system
+
+#define OS_LINUX     1
+
+#if defined(__LINUX__)        // Linux OS
+    #define OS_TARGET OS_LINUX
+#else
+    #error -- "Unsupported OS"
+#endif
+
+
 // Definition of compiler
 
 #define COMPILER_GCC     1
@@ -32,6 +43,7 @@
 #define TARGET_x86          2
 #define TARGET_ARM          3
 #define TARGET_ARM64        4
+#define TARGET_GENERIC      5
 
 #if defined(_AMD64_)
     #define TARGET TARGET_AMD64
@@ -53,6 +65,11 @@
     #define RADIX           64
     #define LOG2RADIX       6  
     typedef uint64_t        digit_t;        // Unsigned 64-bit digit
+#elif defined(_GENERIC_)
+    #define TARGET TARGET_GENERIC
+    #define RADIX           64
+    #define LOG2RADIX       6  
+    typedef uint64_t        digit_t;        // Unsigned 64-bit digit
 #else
     #error -- "Unsupported ARCHITECTURE"
 #endif
@@ -66,10 +83,18 @@
     #define OPTIMIZED_GENERIC_IMPLEMENTATION
 #endif
 
+// Selection of implementation: portable C, no assembly
+
+#if defined(_GENERIC_)
+    #define GENERIC_IMPLEMENTATION
+#endif
+
 
 // Extended datatype support
-                     
-typedef uint64_t uint128_t[2];
+
+#define UINT128_SUPPORT
+typedef unsigned uint128_t __attribute__((mode(TI)));
+typedef int int128_t __attribute__((mode(TI)));
     
 
 // Macro definitions
@@ -106,20 +131,21 @@ static __inline unsigned int is_digit_lessthan_ct(digit_t x, digit_t y)
 
 // Digit multiplication
 #define MUL(multiplier, multiplicand, hi, lo)                                                     \
-    digit_x_digit((multiplier), (multiplicand), &(lo));
-    
+    { uint128_t tempReg = (uint128_t)(multiplier) * (uint128_t)(multiplicand);                    \
+    *(hi) = (digit_t)(tempReg >> RADIX);                                                          \
+    (lo) = (digit_t)tempReg; }
+
 // Digit addition with carry
 #define ADDC(carryIn, addend1, addend2, carryOut, sumOut)                                         \
-    { digit_t tempReg = (addend1) + (digit_t)(carryIn);                                           \
-    (sumOut) = (addend2) + tempReg;                                                               \
-    (carryOut) = (is_digit_lessthan_ct(tempReg, (digit_t)(carryIn)) | is_digit_lessthan_ct((sumOut), tempReg)); }
-
+    { uint128_t tempReg = (uint128_t)(addend1) + (uint128_t)(addend2) + (uint128_t)(carryIn);     \
+    (carryOut) = (digit_t)(tempReg >> RADIX);                                                     \
+    (sumOut) = (digit_t)tempReg; }  
+    
 // Digit subtraction with borrow
 #define SUBC(borrowIn, minuend, subtrahend, borrowOut, differenceOut)                             \
-    { digit_t tempReg = (minuend) - (subtrahend);                                                 \
-    unsigned int borrowReg = (is_digit_lessthan_ct((minuend), (subtrahend)) | ((borrowIn) & is_digit_zero_ct(tempReg)));  \
-    (differenceOut) = tempReg - (digit_t)(borrowIn);                                              \
-    (borrowOut) = borrowReg; }
+    { uint128_t tempReg = (uint128_t)(minuend) - (uint128_t)(subtrahend) - (uint128_t)(borrowIn); \
+    (borrowOut) = (digit_t)(tempReg >> (sizeof(uint128_t)*8 - 1));                                \
+    (differenceOut) = (digit_t)tempReg; }
     
 // Shift right with flexible datatype
 #define SHIFTR(highIn, lowIn, shift, shiftOut, DigitSize)                                         \
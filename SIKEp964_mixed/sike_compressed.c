@@ -0,0 +1,118 @@
+/********************************************************************************************
+* Supersingular Isogeny Key Encapsulation Library
+*
+* Abstract: supersingular isogeny key encapsulation (SIKE) protocol with compressed public keys
+*           and ciphertexts
+*********************************************************************************************/
+
+#include <string.h>
+#include "P964_internal.h"
+#include "sha3/fips202.h"
+
+
+int crypto_kem_keypair_compressed(unsigned char *pk, unsigned char *sk)
+{ // SIKE's key generation with a compressed public key
+  // Outputs: secret key sk (CRYPTO_SECRETKEYBYTES_COMPRESSED = MSG_BYTES + SECRETKEY_B_BYTES + CRYPTO_PUBLICKEYBYTES_COMPRESSED bytes)
+  //          public key pk (CRYPTO_PUBLICKEYBYTES_COMPRESSED bytes)
+    unsigned char pk_[CRYPTO_PUBLICKEYBYTES];
+
+    // Generate lower portion of secret key sk <- s||SK and public key pk, until pk has a compressed form
+    do {
+        randombytes(sk, MSG_BYTES);
+        random_mod_order_B(sk + MSG_BYTES);
+        EphemeralKeyGeneration_B(sk + MSG_BYTES, pk_);
+    } while (PublicKeyCompression_B(pk_, pk) != 0);
+
+    // Append public key pk to secret key sk
+    memcpy(&sk[MSG_BYTES + SECRETKEY_B_BYTES], pk, CRYPTO_PUBLICKEYBYTES_COMPRESSED);
+
+    return 0;
+}
+
+
+int crypto_kem_enc_compressed(unsigned char *ct, unsigned char *ss, const unsigned char *pk)
+{ // SIKE's encapsulation with a compressed public key and ciphertext
+  // Input:   public key pk         (CRYPTO_PUBLICKEYBYTES_COMPRESSED bytes)
+  // Outputs: shared secret ss      (CRYPTO_BYTES bytes)
+  //          ciphertext message ct (CRYPTO_CIPHERTEXTBYTES_COMPRESSED = SIDH_PUBLICKEYBYTES_COMPRESSED_A + MSG_BYTES bytes)
+  // Returns 1 if pk is malformed, 0 otherwise.
+    const uint16_t G = 0;
+    const uint16_t H = 1;
+    const uint16_t P = 2;
+    unsigned char ephemeralsk[SECRETKEY_A_BYTES];
+    unsigned char jinvariant[FP2_ENCODED_BYTES];
+    unsigned char h[MSG_BYTES];
+    unsigned char pk_[CRYPTO_PUBLICKEYBYTES];
+    unsigned char c0_[CRYPTO_PUBLICKEYBYTES];
+    unsigned char temp[CRYPTO_CIPHERTEXTBYTES_COMPRESSED+MSG_BYTES];
+    unsigned int i;
+
+    if (PublicKeyDecompression_B(pk, pk_) != 0) return 1;
+
+    // Generate ephemeralsk <- G(m||pk) mod oA, until the ciphertext has a compressed form
+    do {
+        randombytes(temp, MSG_BYTES);
+        memcpy(&temp[MSG_BYTES], pk, CRYPTO_PUBLICKEYBYTES_COMPRESSED);
+        cshake256_simple(ephemeralsk, SECRETKEY_A_BYTES, G, temp, CRYPTO_PUBLICKEYBYTES_COMPRESSED+MSG_BYTES);
+        ephemeralsk[SECRETKEY_A_BYTES - 1] &= MASK_ALICE;
+        EphemeralKeyGeneration_A(ephemeralsk, c0_);
+    } while (PublicKeyCompression_A(c0_, ct) != 0);
+
+    // Encrypt
+    EphemeralSecretAgreement_A(ephemeralsk, pk_, jinvariant);
+    cshake256_simple(h, MSG_BYTES, P, jinvariant, FP2_ENCODED_BYTES);
+    for (i = 0; i < MSG_BYTES; i++) ct[i + SIDH_PUBLICKEYBYTES_COMPRESSED_A] = temp[i] ^ h[i];
+
+    // Generate shared secret ss <- H(m||ct)
+    memcpy(&temp[MSG_BYTES], ct, CRYPTO_CIPHERTEXTBYTES_COMPRESSED);
+    cshake256_simple(ss, CRYPTO_BYTES, H, temp, CRYPTO_CIPHERTEXTBYTES_COMPRESSED+MSG_BYTES);
+
+    return 0;
+}
+
+
+int crypto_kem_dec_compressed(unsigned char *ss, const unsigned char *ct, const unsigned char *sk)
+{ // SIKE's decapsulation with a compressed public key and ciphertext
+  // Input:   secret key sk         (CRYPTO_SECRETKEYBYTES_COMPRESSED = MSG_BYTES + SECRETKEY_B_BYTES + CRYPTO_PUBLICKEYBYTES_COMPRESSED bytes)
+  //          ciphertext message ct (CRYPTO_CIPHERTEXTBYTES_COMPRESSED = SIDH_PUBLICKEYBYTES_COMPRESSED_A + MSG_BYTES bytes)
+  // Outputs: shared secret ss      (CRYPTO_BYTES bytes)
+    const uint16_t G = 0;
+    const uint16_t H = 1;
+    const uint16_t P = 2;
+    unsigned char ephemeralsk_[SECRETKEY_A_BYTES];
+    unsigned char jinvariant_[FP2_ENCODED_BYTES];
+    unsigned char h_[MSG_BYTES];
+    unsigned char ct_[CRYPTO_PUBLICKEYBYTES];
+    unsigned char c0_[CRYPTO_PUBLICKEYBYTES];
+    unsigned char temp[CRYPTO_CIPHERTEXTBYTES_COMPRESSED+MSG_BYTES];
+    unsigned int i;
+
+    // A malformed ciphertext is rejected, ss <- H(s||ct)
+    if (PublicKeyDecompression_A(ct, ct_) != 0) {
+        memcpy(temp, sk, MSG_BYTES);
+        memcpy(&temp[MSG_BYTES], ct, CRYPTO_CIPHERTEXTBYTES_COMPRESSED);
+        cshake256_simple(ss, CRYPTO_BYTES, H, temp, CRYPTO_CIPHERTEXTBYTES_COMPRESSED+MSG_BYTES);
+        return 0;
+    }
+
+    // Decrypt
+    EphemeralSecretAgreement_B(sk + MSG_BYTES, ct_, jinvariant_);
+    cshake256_simple(h_, MSG_BYTES, P, jinvariant_, FP2_ENCODED_BYTES);
+    for (i = 0; i < MSG_BYTES; i++) temp[i] = ct[i + SIDH_PUBLICKEYBYTES_COMPRESSED_A] ^ h_[i];
+
+    // Generate ephemeralsk_ <- G(m||pk) mod oA
+    memcpy(&temp[MSG_BYTES], &sk[MSG_BYTES + SECRETKEY_B_BYTES], CRYPTO_PUBLICKEYBYTES_COMPRESSED);
+    cshake256_simple(ephemeralsk_, SECRETKEY_A_BYTES, G, temp, CRYPTO_PUBLICKEYBYTES_COMPRESSED+MSG_BYTES);
+    ephemeralsk_[SECRETKEY_A_BYTES - 1] &= MASK_ALICE;
+
+    // Generate shared secret ss <- H(m||ct) or output ss <- H(s||ct). The public key in ct decompresses to the exact public key
+    // of its encryption, so c0_ is compared with ct_ instead of being compressed with the variable-time PublicKeyCompression_A
+    EphemeralKeyGeneration_A(ephemeralsk_, c0_);
+    if (memcmp(c0_, ct_, CRYPTO_PUBLICKEYBYTES) != 0) {
+        memcpy(temp, sk, MSG_BYTES);
+    }
+    memcpy(&temp[MSG_BYTES], ct, CRYPTO_CIPHERTEXTBYTES_COMPRESSED);
+    cshake256_simple(ss, CRYPTO_BYTES, H, temp, CRYPTO_CIPHERTEXTBYTES_COMPRESSED+MSG_BYTES);
+
+    return 0;
+}
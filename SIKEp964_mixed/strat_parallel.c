@@ -0,0 +1,115 @@
+/********************************************************************************************
+* Supersingular Isogeny Key Encapsulation Library
+*
+* Abstract: strategies for the isogeny tree traversal in p964 = 2^486*3^301-1
+*           Generated by tools/gen_strategy.c, do not edit.
+*
+* Costs in multiplications in GF(p): xDBL 16, xTPL 22, get_4_isog 8, eval_4_isog 16,
+* get_3_isog 12, eval_3_isog 10. Simulated key generation plus shared secret:
+* 2 cores: Alice 81160 (sequential strategy 81880), Bob 68998 (69254)
+* 3 cores: Alice 74776 (sequential strategy 76016), Bob 63196 (63510)
+* 4 cores: Alice 71936 (sequential strategy 73528), Bob 60726 (61172)
+*********************************************************************************************/
+
+#if (_ISOG_THREADS_ == 2)
+const unsigned int strat_Alice[MAX_Alice] = {
+0, 1, 1, 2, 2, 2, 3, 4, 3, 3, 4, 5, 3, 4, 5, 8, 4, 8, 5, 8, 9, 10, 6, 5, 11, 11, 
+12, 12, 13, 10, 12, 16, 16, 16, 13, 16, 16, 17, 17, 17, 17, 18, 19, 19, 18, 19, 
+20, 21, 21, 21, 22, 21, 24, 19, 24, 25, 26, 27, 27, 28, 29, 23, 24, 35, 32, 32, 
+32, 32, 32, 32, 33, 33, 33, 34, 35, 36, 34, 33, 36, 37, 33, 34, 35, 38, 38, 38, 
+38, 38, 38, 38, 38, 39, 38, 41, 42, 38, 44, 41, 41, 47, 44, 44, 45, 46, 47, 48, 
+49, 50, 48, 48, 48, 49, 51, 51, 52, 53, 54, 55, 56, 57, 58, 59, 60, 61, 61, 62, 
+63, 64, 64, 64, 64, 64, 64, 64, 64, 65, 66, 66, 65, 65, 66, 67, 65, 69, 65, 69, 
+67, 65, 69, 66, 66, 67, 68, 69, 70, 71, 71, 71, 72, 71, 71, 71, 71, 72, 73, 72, 
+72, 71, 74, 73, 72, 72, 71, 74, 73, 84, 71, 74, 85, 79, 84, 78, 77, 85, 85, 84, 
+81, 84, 85, 84, 85, 86, 86, 87, 86, 87, 86, 87, 86, 86, 87, 88, 89, 88, 89, 92, 
+91, 92, 95, 91, 92, 91, 92, 95, 101, 95, 98, 97, 98, 99, 100, 103, 102, 103, 104, 
+105, 106, 106, 106, 106, 107, 108, 110, 108, 109, 110, 113, 111, 112, 114, 115, 
+116, 117 };
+
+const unsigned int strat_Bob[MAX_Bob] = {
+0, 1, 1, 2, 2, 2, 3, 3, 3, 5, 3, 5, 4, 5, 6, 5, 7, 5, 5, 6, 9, 8, 9, 8, 6, 10, 
+11, 9, 11, 12, 12, 12, 11, 13, 14, 15, 16, 16, 16, 16, 16, 16, 16, 16, 17, 18, 
+19, 16, 16, 21, 22, 21, 21, 21, 22, 23, 24, 22, 22, 23, 28, 25, 27, 27, 28, 28, 
+28, 28, 25, 28, 28, 29, 28, 29, 28, 28, 28, 30, 31, 32, 33, 33, 34, 35, 36, 37, 
+37, 38, 37, 38, 37, 37, 38, 38, 39, 38, 38, 39, 41, 38, 42, 39, 38, 39, 40, 41, 
+42, 43, 44, 45, 49, 47, 48, 49, 49, 49, 51, 50, 49, 49, 44, 49, 49, 51, 51, 49, 
+54, 54, 49, 53, 50, 53, 52, 53, 54, 55, 55, 55, 55, 55, 57, 56, 60, 61, 59, 60, 
+61, 64, 63, 64, 65, 65, 65, 65, 65, 65, 65, 65, 66, 66, 66, 67, 66, 66, 68, 69, 
+70, 66, 66, 66, 74, 68, 66, 67, 66, 66, 66, 71, 68, 69, 70, 71, 71, 71, 74, 77, 
+76, 77, 78, 78, 78, 80, 80, 81, 81, 82, 83, 84, 85, 86, 86, 86, 87, 86, 87, 88, 
+89, 87, 88, 89, 90, 87, 88, 89, 87, 88, 89, 90, 87, 88, 89, 90, 87, 88, 89, 90, 
+91, 92, 93, 94, 93, 94, 95, 96, 97, 93, 93, 93, 94, 95, 96, 97, 95, 103, 94, 95, 
+96, 97, 101, 99, 107, 107, 102, 103, 104, 108, 106, 107, 108, 109, 110, 111, 112, 
+113, 114, 114, 114, 114, 114, 115, 114, 114, 114, 115, 115, 115, 115, 115, 117, 
+115, 115, 116, 115, 115, 119, 115, 121, 115, 116, 115, 118, 119, 115, 128, 115, 
+116, 115, 125, 119, 115, 121 };
+#elif (_ISOG_THREADS_ == 3)
+const unsigned int strat_Alice[MAX_Alice] = {
+0, 1, 1, 2, 2, 1, 3, 4, 2, 1, 4, 5, 4, 4, 5, 9, 4, 8, 6, 8, 9, 6, 6, 5, 11, 11, 
+12, 12, 13, 10, 12, 16, 16, 16, 14, 16, 16, 17, 17, 17, 17, 18, 19, 19, 18, 19, 
+20, 21, 21, 21, 22, 21, 24, 23, 24, 25, 26, 27, 27, 28, 29, 23, 24, 35, 32, 32, 
+32, 32, 32, 32, 33, 33, 33, 34, 35, 36, 34, 33, 36, 37, 33, 34, 35, 38, 38, 38, 
+38, 38, 38, 38, 38, 39, 38, 41, 42, 38, 44, 41, 41, 47, 44, 44, 45, 46, 47, 48, 
+49, 50, 48, 48, 48, 49, 51, 51, 52, 53, 54, 55, 56, 57, 58, 59, 60, 61, 61, 62, 
+63, 64, 64, 64, 64, 64, 64, 64, 64, 65, 66, 66, 65, 65, 66, 67, 65, 69, 65, 69, 
+67, 65, 69, 66, 66, 67, 68, 69, 70, 71, 71, 71, 72, 71, 71, 71, 71, 72, 73, 72, 
+72, 71, 74, 73, 72, 72, 71, 74, 73, 84, 71, 74, 85, 79, 84, 78, 77, 85, 85, 84, 
+81, 84, 85, 84, 85, 86, 86, 87, 86, 87, 86, 87, 86, 86, 87, 88, 89, 88, 89, 92, 
+91, 92, 95, 91, 92, 91, 92, 95, 101, 95, 98, 97, 98, 99, 100, 103, 102, 103, 104, 
+105, 106, 106, 106, 106, 107, 108, 110, 108, 109, 110, 113, 111, 112, 114, 115, 
+116, 117 };
+
+const unsigned int strat_Bob[MAX_Bob] = {
+0, 1, 1, 2, 2, 1, 3, 3, 3, 5, 3, 5, 5, 5, 6, 5, 7, 2, 6, 7, 9, 9, 9, 8, 6, 10, 
+11, 9, 11, 12, 12, 12, 11, 13, 14, 15, 16, 16, 16, 16, 16, 16, 16, 16, 17, 18, 
+19, 16, 16, 21, 22, 21, 21, 21, 22, 23, 24, 22, 22, 23, 28, 25, 27, 27, 28, 28, 
+28, 28, 25, 28, 28, 29, 28, 29, 28, 28, 28, 30, 31, 32, 33, 33, 34, 35, 36, 37, 
+37, 38, 37, 38, 37, 37, 38, 38, 39, 38, 38, 39, 41, 38, 42, 39, 38, 39, 40, 41, 
+42, 43, 44, 45, 46, 47, 48, 49, 49, 49, 51, 50, 49, 49, 44, 49, 49, 51, 51, 49, 
+54, 54, 49, 53, 50, 53, 52, 53, 54, 55, 55, 55, 55, 55, 57, 56, 60, 61, 59, 60, 
+61, 64, 63, 64, 65, 65, 65, 65, 65, 65, 65, 65, 66, 66, 66, 67, 66, 66, 68, 69, 
+70, 66, 66, 66, 74, 68, 66, 67, 66, 66, 66, 71, 68, 69, 70, 71, 71, 71, 74, 77, 
+76, 77, 78, 78, 78, 80, 80, 81, 81, 82, 83, 84, 85, 86, 86, 86, 87, 86, 87, 88, 
+89, 87, 88, 89, 90, 87, 88, 89, 87, 88, 89, 90, 87, 88, 89, 90, 87, 88, 89, 90, 
+91, 92, 93, 94, 93, 94, 95, 96, 97, 93, 93, 93, 94, 95, 96, 97, 95, 103, 94, 95, 
+96, 97, 101, 99, 107, 107, 102, 103, 104, 108, 106, 107, 108, 109, 110, 111, 112, 
+113, 114, 114, 114, 114, 114, 115, 114, 114, 114, 115, 115, 115, 115, 115, 117, 
+115, 115, 116, 115, 115, 119, 115, 121, 115, 116, 115, 118, 119, 115, 128, 115, 
+116, 115, 125, 119, 115, 121 };
+#elif (_ISOG_THREADS_ == 4)
+const unsigned int strat_Alice[MAX_Alice] = {
+0, 1, 1, 2, 2, 1, 3, 4, 3, 3, 4, 5, 3, 1, 5, 8, 4, 8, 6, 8, 9, 10, 6, 5, 11, 11, 
+12, 12, 13, 10, 12, 16, 16, 16, 14, 16, 16, 17, 17, 17, 17, 18, 19, 19, 18, 19, 
+20, 21, 21, 21, 22, 21, 24, 23, 24, 25, 26, 27, 27, 28, 29, 23, 24, 35, 32, 32, 
+32, 32, 32, 32, 33, 33, 33, 34, 35, 36, 34, 33, 36, 37, 33, 34, 35, 38, 38, 38, 
+38, 38, 38, 38, 38, 39, 38, 41, 42, 38, 44, 41, 41, 47, 44, 44, 45, 46, 47, 48, 
+49, 50, 48, 48, 48, 49, 51, 51, 52, 53, 54, 55, 56, 57, 58, 59, 60, 61, 61, 62, 
+63, 64, 64, 64, 64, 64, 64, 64, 64, 65, 66, 66, 65, 65, 66, 67, 65, 69, 65, 69, 
+67, 65, 69, 66, 66, 67, 68, 69, 70, 71, 71, 71, 72, 71, 71, 71, 71, 72, 73, 72, 
+72, 71, 74, 73, 72, 72, 71, 74, 73, 84, 71, 74, 85, 79, 84, 78, 77, 85, 85, 84, 
+81, 84, 85, 84, 85, 86, 86, 87, 86, 87, 86, 87, 86, 86, 87, 88, 89, 88, 89, 92, 
+91, 92, 95, 91, 92, 91, 92, 95, 101, 95, 98, 97, 98, 99, 100, 103, 102, 103, 104, 
+105, 106, 106, 106, 106, 107, 108, 110, 108, 109, 110, 113, 111, 112, 114, 115, 
+116, 117 };
+
+const unsigned int strat_Bob[MAX_Bob] = {
+0, 1, 1, 2, 2, 1, 3, 3, 3, 5, 3, 5, 5, 5, 6, 5, 7, 2, 6, 9, 9, 9, 9, 8, 6, 10, 
+11, 9, 11, 12, 12, 12, 11, 13, 14, 15, 16, 16, 16, 16, 16, 16, 16, 16, 17, 18, 
+19, 16, 16, 21, 22, 21, 21, 21, 22, 23, 24, 22, 22, 23, 28, 25, 27, 27, 28, 28, 
+28, 28, 25, 28, 28, 29, 28, 29, 28, 28, 28, 30, 31, 32, 33, 33, 34, 35, 36, 37, 
+37, 38, 37, 38, 37, 37, 38, 38, 39, 38, 38, 39, 41, 38, 42, 39, 38, 39, 40, 41, 
+42, 43, 44, 45, 46, 47, 48, 49, 49, 49, 51, 50, 49, 49, 44, 49, 49, 51, 51, 49, 
+54, 54, 49, 53, 50, 53, 52, 53, 54, 55, 55, 55, 55, 55, 57, 56, 60, 61, 59, 60, 
+61, 64, 63, 64, 65, 65, 65, 65, 65, 65, 65, 65, 66, 66, 66, 67, 66, 66, 68, 69, 
+70, 66, 66, 66, 74, 68, 66, 67, 66, 66, 66, 71, 68, 69, 70, 71, 71, 71, 74, 77, 
+76, 77, 78, 78, 78, 80, 80, 81, 81, 82, 83, 84, 85, 86, 86, 86, 87, 86, 87, 88, 
+89, 87, 88, 89, 90, 87, 88, 89, 87, 88, 89, 90, 87, 88, 89, 90, 87, 88, 89, 90, 
+91, 92, 93, 94, 93, 94, 95, 96, 97, 93, 93, 93, 94, 95, 96, 97, 95, 103, 94, 95, 
+96, 97, 101, 99, 107, 107, 102, 103, 104, 108, 106, 107, 108, 109, 110, 111, 112, 
+113, 114, 114, 114, 114, 114, 115, 114, 114, 114, 115, 115, 115, 115, 115, 117, 
+115, 115, 116, 115, 115, 119, 115, 121, 115, 116, 115, 118, 119, 115, 128, 115, 
+116, 115, 125, 119, 115, 121 };
+#else
+    #error -- "No strategy for _ISOG_THREADS_ cores"
+#endif
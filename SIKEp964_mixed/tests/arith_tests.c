@@ -0,0 +1,816 @@
+/********************************************************************************************
+* Supersingular Isogeny Key Encapsulation Library
+*
+* Abstract: testing/benchmarking the paired field multiplications and the field inversions for P964.
+*           The library sources are included directly so the inputs of the variable-time inversion can be traced.
+*********************************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include "../P964_internal.h"
+
+static void bingcd_trace(const digit_t* a);
+#define BINGCD_TRACE(a)   bingcd_trace(a)
+#define _LADDER_TESTS_                             // Both 3-point ladder engines, whatever LADDER selects
+#include "../P964.c"
+#include "../random/random.h"
+#include "test_extras.h"
+
+
+// Benchmark and test parameters
+#define BENCH_LOOPS       10000
+#define TEST_LOOPS        1000
+#define NWAY_MAX          8
+
+#define TRACE_MAX         16
+#if defined(_PROJECTIVE_A_)
+#define TRACE_AGREEMENT   0                     // get_A_proj does not invert
+#else
+#define TRACE_AGREEMENT   1
+#endif
+
+static felm_t trace_in[TRACE_MAX];
+static unsigned int trace_count;
+
+
+static void bingcd_trace(const digit_t* a)
+{ // Recording the inputs of fpinv964_mont_bingcd
+    if (trace_count < TRACE_MAX) fpcopy964(a, trace_in[trace_count]);
+    trace_count++;
+}
+
+
+static void fprandom964_test(digit_t* a)
+{ // Generating a pseudo-random field element in [0, p964-1]
+    randombytes((unsigned char*)a, NWORDS_FIELD*sizeof(digit_t));
+    a[NWORDS_FIELD-1] %= p964[NWORDS64_FIELD-1];
+}
+
+
+static void fp2random964_test(felm_t* a)
+{ // Generating a pseudo-random element in GF(p964^2)
+    fprandom964_test(a[0]);
+    fprandom964_test(a[1]);
+}
+
+
+int arith_test_x2()
+{ // Testing the paired multiplications against two single multiplications
+    unsigned int n;
+    felm_t a0, b0, a1, b1, c0, c1, d0, d1;
+    f2elm_t e0, f0, e1, f1, g0, g1, h0, h1;
+    bool passed = true;
+
+    printf("\n\nTESTING PAIRED FIELD MULTIPLICATIONS OVER GF(p964)\n");
+    printf("--------------------------------------------------------------------------------------------------------\n\n");
+
+    for (n = 0; n < TEST_LOOPS; n++)
+    {
+        fprandom964_test(a0); fprandom964_test(b0); fprandom964_test(a1); fprandom964_test(b1);
+        fpmul964_mont(a0, b0, c0);
+        fpmul964_mont(a1, b1, c1);
+        fpmul964_mont_x2(a0, b0, d0, a1, b1, d1);
+        fpcorrection964(c0); fpcorrection964(c1); fpcorrection964(d0); fpcorrection964(d1);
+        if (memcmp(c0, d0, sizeof(felm_t)) != 0 || memcmp(c1, d1, sizeof(felm_t)) != 0) { passed = false; break; }
+
+        fpmul964_mont_x2(a0, b0, a0, a1, b1, b1);        // Outputs overlapping the inputs
+        fpcorrection964(a0); fpcorrection964(b1);
+        if (memcmp(c0, a0, sizeof(felm_t)) != 0 || memcmp(c1, b1, sizeof(felm_t)) != 0) { passed = false; break; }
+    }
+    if (passed == true) printf("  GF(p) paired multiplication tests ............................ PASSED");
+    else { printf("  GF(p) paired multiplication tests ... FAILED"); printf("\n"); return FAILED; }
+    printf("\n");
+
+    for (n = 0; n < TEST_LOOPS; n++)
+    {
+        fp2random964_test(e0); fp2random964_test(f0); fp2random964_test(e1); fp2random964_test(f1);
+        fp2mul964_mont(e0, f0, g0);
+        fp2mul964_mont(e1, f1, g1);
+        fp2mul964_mont_x2(e0, f0, h0, e1, f1, h1);
+        fp2correction964(g0); fp2correction964(g1); fp2correction964(h0); fp2correction964(h1);
+        if (memcmp(g0, h0, sizeof(f2elm_t)) != 0 || memcmp(g1, h1, sizeof(f2elm_t)) != 0) { passed = false; break; }
+
+        fp2mul964_mont_x2(e0, f0, f1, e1, f1, e0);       // Outputs overlapping the inputs
+        fp2correction964(f1); fp2correction964(e0);
+        if (memcmp(g0, f1, sizeof(f2elm_t)) != 0 || memcmp(g1, e0, sizeof(f2elm_t)) != 0) { passed = false; break; }
+    }
+    if (passed == true) printf("  GF(p^2) paired multiplication tests .......................... PASSED");
+    else { printf("  GF(p^2) paired multiplication tests ... FAILED"); printf("\n"); return FAILED; }
+    printf("\n");
+
+    return PASSED;
+}
+
+
+int arith_run_x2()
+{ // Benchmarking the paired multiplications against two single multiplications
+    unsigned int n;
+    unsigned long long cycles, cycles1, cycles2;
+    felm_t a0, b0, a1, b1;
+    f2elm_t e0, f0, e1, f1;
+
+    printf("\n\nBENCHMARKING PAIRED FIELD MULTIPLICATIONS OVER GF(p964)\n");
+    printf("--------------------------------------------------------------------------------------------------------\n\n");
+
+    fprandom964_test(a0); fprandom964_test(b0); fprandom964_test(a1); fprandom964_test(b1);
+    fp2random964_test(e0); fp2random964_test(f0); fp2random964_test(e1); fp2random964_test(f1);
+
+    cycles = 0;
+    for (n = 0; n < BENCH_LOOPS; n++)
+    {
+        cycles1 = cpucycles();
+        fpmul964_mont(a0, b0, a0);
+        fpmul964_mont(a1, b1, a1);
+        cycles2 = cpucycles();
+        cycles = cycles+(cycles2-cycles1);
+    }
+    printf("  2 x GF(p) multiplication runs in ............................. %10lld ", cycles/BENCH_LOOPS); print_unit;
+    printf("\n");
+
+    cycles = 0;
+    for (n = 0; n < BENCH_LOOPS; n++)
+    {
+        cycles1 = cpucycles();
+        fpmul964_mont_x2(a0, b0, a0, a1, b1, a1);
+        cycles2 = cpucycles();
+        cycles = cycles+(cycles2-cycles1);
+    }
+    printf("  GF(p) paired multiplication runs in .......................... %10lld ", cycles/BENCH_LOOPS); print_unit;
+    printf("\n");
+
+    cycles = 0;
+    for (n = 0; n < BENCH_LOOPS; n++)
+    {
+        cycles1 = cpucycles();
+        fp2mul964_mont(e0, f0, e0);
+        fp2mul964_mont(e1, f1, e1);
+        cycles2 = cpucycles();
+        cycles = cycles+(cycles2-cycles1);
+    }
+    printf("  2 x GF(p^2) multiplication runs in ........................... %10lld ", cycles/BENCH_LOOPS); print_unit;
+    printf("\n");
+
+    cycles = 0;
+    for (n = 0; n < BENCH_LOOPS; n++)
+    {
+        cycles1 = cpucycles();
+        fp2mul964_mont_x2(e0, f0, e0, e1, f1, e1);
+        cycles2 = cpucycles();
+        cycles = cycles+(cycles2-cycles1);
+    }
+    printf("  GF(p^2) paired multiplication runs in ........................ %10lld ", cycles/BENCH_LOOPS); print_unit;
+    printf("\n");
+
+    return PASSED;
+}
+
+
+int arith_test_inv()
+{ // Testing the safegcd inversion against the exponentiation-based inversion, and the n-way inversions
+    unsigned int n, i, k;
+    felm_t a, b, c, d;
+    f2elm_t v[NWAY_MAX], w[NWAY_MAX], u[NWAY_MAX], mask;
+    bool passed = true;
+
+    printf("\n\nTESTING FIELD INVERSIONS OVER GF(p964)\n");
+    printf("--------------------------------------------------------------------------------------------------------\n\n");
+
+    for (n = 0; n < TEST_LOOPS; n++)
+    {
+        fprandom964_test(a);
+        fpcopy964(a, b); fpinv964_mont_safegcd(b);
+        fpmul964_mont(a, b, d);
+        fpcorrection964(b); fpcorrection964(d);
+        if (memcmp(d, Montgomery_one, sizeof(felm_t)) != 0) { passed = false; break; }
+        fpcopy964(a, c); fpinv964_mont(c);
+        fpcorrection964(c);
+        if (memcmp(b, c, sizeof(felm_t)) != 0) { passed = false; break; }
+    }
+    fpzero964(a);
+    fpinv964_mont_safegcd(a);                            // Zero is mapped to zero
+    fpcorrection964(a); fpzero964(b);
+    if (memcmp(a, b, sizeof(felm_t)) != 0) passed = false;
+    if (passed == true) printf("  GF(p) safegcd inversion tests ................................ PASSED");
+    else { printf("  GF(p) safegcd inversion tests ... FAILED"); printf("\n"); return FAILED; }
+    printf("\n");
+
+    for (n = 0; n < TEST_LOOPS; n++)
+    {
+        k = 1 + n % NWAY_MAX;
+        for (i = 0; i < k; i++) {
+            fp2random964_test(v[i]);
+            fp2copy964(v[i], w[i]); fp2inv964_mont(w[i]);
+            fp2correction964(w[i]);
+        }
+        mont_n_way_inv((const f2elm_t*)v, k, u);
+        for (i = 0; i < k; i++) fp2correction964(u[i]);
+        if (memcmp(u, w, k*sizeof(f2elm_t)) != 0) { passed = false; break; }
+
+        fp2random964_test(mask);
+        mont_n_way_inv_bingcd((const f2elm_t*)v, k, u, mask);
+        for (i = 0; i < k; i++) fp2correction964(u[i]);
+        if (memcmp(u, w, k*sizeof(f2elm_t)) != 0) { passed = false; break; }
+    }
+    if (passed == true) printf("  GF(p^2) n-way inversion tests ................................ PASSED");
+    else { printf("  GF(p^2) n-way inversion tests ... FAILED"); printf("\n"); return FAILED; }
+    printf("\n");
+
+    return PASSED;
+}
+
+
+int arith_run_inv()
+{ // Benchmarking the safegcd inversion against the exponentiation-based inversion, and the n-way inversion
+    unsigned int n, i;
+    unsigned long long cycles, cycles1, cycles2;
+    felm_t a;
+    f2elm_t v[NWAY_MAX], u[NWAY_MAX];
+
+    printf("\n\nBENCHMARKING FIELD INVERSIONS OVER GF(p964)\n");
+    printf("--------------------------------------------------------------------------------------------------------\n\n");
+
+    fprandom964_test(a);
+
+    cycles = 0;
+    for (n = 0; n < BENCH_LOOPS/10; n++)
+    {
+        cycles1 = cpucycles();
+        fpinv964_mont(a);
+        cycles2 = cpucycles();
+        cycles = cycles+(cycles2-cycles1);
+    }
+    printf("  GF(p) inversion (fpinv_mont) runs in ......................... %10lld ", cycles/(BENCH_LOOPS/10)); print_unit;
+    printf("\n");
+
+    cycles = 0;
+    for (n = 0; n < BENCH_LOOPS/10; n++)
+    {
+        cycles1 = cpucycles();
+        fpinv964_mont_safegcd(a);
+        cycles2 = cpucycles();
+        cycles = cycles+(cycles2-cycles1);
+    }
+    printf("  GF(p) safegcd inversion runs in .............................. %10lld ", cycles/(BENCH_LOOPS/10)); print_unit;
+    printf("\n");
+
+    cycles = 0;
+    for (n = 0; n < BENCH_LOOPS/10; n++)
+    {
+        cycles1 = cpucycles();
+        fpinv964_mont_bingcd(a);
+        cycles2 = cpucycles();
+        cycles = cycles+(cycles2-cycles1);
+    }
+    printf("  GF(p) binary GCD inversion (variable-time) runs in ........... %10lld ", cycles/(BENCH_LOOPS/10)); print_unit;
+    printf("\n");
+
+    for (i = 0; i < NWAY_MAX; i++) fp2random964_test(v[i]);
+
+    cycles = 0;
+    for (n = 0; n < BENCH_LOOPS/10; n++)
+    {
+        cycles1 = cpucycles();
+        for (i = 0; i < NWAY_MAX; i++) fp2inv964_mont(v[i]);
+        cycles2 = cpucycles();
+        cycles = cycles+(cycles2-cycles1);
+    }
+    printf("  %d x GF(p^2) inversion runs in ................................ %10lld ", NWAY_MAX, cycles/(BENCH_LOOPS/10)); print_unit;
+    printf("\n");
+
+    cycles = 0;
+    for (n = 0; n < BENCH_LOOPS/10; n++)
+    {
+        cycles1 = cpucycles();
+        mont_n_way_inv((const f2elm_t*)v, NWAY_MAX, u);
+        cycles2 = cpucycles();
+        cycles = cycles+(cycles2-cycles1);
+    }
+    printf("  GF(p^2) %d-way inversion runs in .............................. %10lld ", NWAY_MAX, cycles/(BENCH_LOOPS/10)); print_unit;
+    printf("\n");
+
+    return PASSED;
+}
+
+
+int arith_test_bingcd()
+{ // Testing the binary GCD inversions, and that only public or masked values reach them
+    unsigned int n, i, r3;
+    felm_t a, b, c;
+    f2elm_t e, f;
+    digit_t x[NWORDS_ORDER], y[NWORDS_ORDER], z[NWORDS_ORDER], one[NWORDS_ORDER] = {0};
+    digit_t skA[2][NWORDS_ORDER], skB[2][NWORDS_ORDER];    // Whole words, random_mod_order_A/B clear NWORDS_ORDER words
+    unsigned char pkA[CRYPTO_PUBLICKEYBYTES], pkB[CRYPTO_PUBLICKEYBYTES];
+    unsigned char ssA[FP2_ENCODED_BYTES], ssB[FP2_ENCODED_BYTES];
+    unsigned char pkc[CRYPTO_PUBLICKEYBYTES_COMPRESSED], skc[2][CRYPTO_SECRETKEYBYTES_COMPRESSED], ctc[CRYPTO_CIPHERTEXTBYTES_COMPRESSED];
+    unsigned char ssc[CRYPTO_BYTES], ssc_[CRYPTO_BYTES];
+    unsigned int ndec;
+    felm_t traced[2], traced_dec[2][TRACE_MAX];
+    bool passed = true;
+
+    printf("\n\nTESTING BINARY GCD INVERSIONS OVER GF(p964)\n");
+    printf("--------------------------------------------------------------------------------------------------------\n\n");
+
+    for (n = 0; n < TEST_LOOPS; n++)
+    {
+        fprandom964_test(a);
+        fpcopy964(a, b); fpinv964_mont_bingcd(b);
+        fpcopy964(a, c); fpinv964_mont(c);
+        fpcorrection964(b); fpcorrection964(c);
+        if (memcmp(b, c, sizeof(felm_t)) != 0) { passed = false; break; }
+
+        fp2random964_test(e);
+        fp2copy964(e, f); fp2inv964_mont_bingcd(f);
+        fp2inv964_mont(e);
+        fp2correction964(e); fp2correction964(f);
+        if (memcmp(e, f, sizeof(f2elm_t)) != 0) { passed = false; break; }
+    }
+    fpzero964(a);
+    fpinv964_mont_bingcd(a);                             // Zero is mapped to zero
+    fpcorrection964(a); fpzero964(b);
+    if (memcmp(a, b, sizeof(felm_t)) != 0) passed = false;
+    if (passed == true) printf("  GF(p) and GF(p^2) binary GCD inversion tests ................. PASSED");
+    else { printf("  GF(p) and GF(p^2) binary GCD inversion tests ... FAILED"); printf("\n"); return FAILED; }
+    printf("\n");
+
+    one[0] = 1;
+    to_Montgomery_mod_order(one, one, (digit_t*)Bob_order, (digit_t*)Montgomery_rprime, (digit_t*)Montgomery_Rprime);
+    for (n = 0; n < TEST_LOOPS; n++)
+    {
+        randombytes((unsigned char*)x, NWORDS_ORDER*sizeof(digit_t));
+        x[NWORDS_ORDER-1] %= ((digit_t*)Bob_order)[NWORDS_ORDER-1];
+        for (i = 0, r3 = 0; i < NWORDS_ORDER; i++) r3 += (unsigned int)(x[i] % 3);    // x mod 3, as 2^64 = 1 mod 3
+        if (r3 % 3 == 0) continue;                                                       // x is not invertible modulo 3^eB
+        to_Montgomery_mod_order(x, x, (digit_t*)Bob_order, (digit_t*)Montgomery_rprime, (digit_t*)Montgomery_Rprime);
+        Montgomery_inversion_mod_order_bingcd(x, y, (digit_t*)Bob_order, (digit_t*)Montgomery_rprime, (digit_t*)Montgomery_Rprime);
+        Montgomery_multiply_mod_order(x, y, z, (digit_t*)Bob_order, (digit_t*)Montgomery_rprime);
+        if (memcmp(z, one, sizeof(z)) != 0) { passed = false; break; }
+    }
+    if (passed == true) printf("  Z_oB binary GCD inversion tests .............................. PASSED");
+    else { printf("  Z_oB binary GCD inversion tests ... FAILED"); printf("\n"); return FAILED; }
+    printf("\n");
+
+    // Key generation only inverts the masked product of the Z coordinates, once
+    random_mod_order_A((unsigned char*)skA[0]); random_mod_order_A((unsigned char*)skA[1]);
+    random_mod_order_B((unsigned char*)skB[0]); random_mod_order_B((unsigned char*)skB[1]);
+    trace_count = 0;
+    EphemeralKeyGeneration_A((unsigned char*)skA[0], pkA);
+    if (trace_count != 1) passed = false;
+    trace_count = 0;
+    EphemeralKeyGeneration_B((unsigned char*)skB[0], pkB);
+    if (trace_count != 1) passed = false;
+
+    // Secret agreement only inverts in get_A (not at all with get_A_proj), and its input depends on the received public key alone
+    for (i = 0; i < 2; i++) {
+        trace_count = 0;
+        EphemeralSecretAgreement_A((unsigned char*)skA[i], pkB, ssA);
+        if (trace_count != TRACE_AGREEMENT) passed = false;
+        fpcopy964(trace_in[0], traced[i]);
+    }
+    if (memcmp(traced[0], traced[1], sizeof(felm_t)) != 0) passed = false;
+    for (i = 0; i < 2; i++) {
+        trace_count = 0;
+        EphemeralSecretAgreement_B((unsigned char*)skB[i], pkA, ssB);
+        if (trace_count != TRACE_AGREEMENT) passed = false;
+        fpcopy964(trace_in[0], traced[i]);
+    }
+    if (memcmp(traced[0], traced[1], sizeof(felm_t)) != 0) passed = false;
+
+    // The shared secrets agree, so the public keys were normalized correctly
+    EphemeralSecretAgreement_A((unsigned char*)skA[0], pkB, ssA);
+    EphemeralSecretAgreement_B((unsigned char*)skB[0], pkA, ssB);
+    if (memcmp(ssA, ssB, sizeof(ssA)) != 0) passed = false;
+
+    // Decapsulation of a compressed ciphertext with a tampered message only inverts values of the ciphertext and the masked
+    // product of its re-encryption, so the traces with two secret keys agree but for their last input
+    crypto_kem_keypair_compressed(pkc, skc[0]);
+    crypto_kem_keypair_compressed(pkc, skc[1]);
+    crypto_kem_enc_compressed(ctc, ssc, pkc);
+    ctc[CRYPTO_CIPHERTEXTBYTES_COMPRESSED-1] ^= 1;
+    trace_count = 0;
+    PublicKeyDecompression_A(ctc, pkA);
+    ndec = trace_count + TRACE_AGREEMENT + 1;
+    for (i = 0; i < 2; i++) {
+        trace_count = 0;
+        crypto_kem_dec_compressed(ssc_, ctc, skc[i]);
+        if (trace_count != ndec || memcmp(ssc, ssc_, CRYPTO_BYTES) == 0) passed = false;
+        memcpy(traced_dec[i], trace_in, sizeof(trace_in));
+    }
+    if (ndec > TRACE_MAX || memcmp(traced_dec[0], traced_dec[1], (ndec-1)*sizeof(felm_t)) != 0) passed = false;
+    if (passed == true) printf("  Binary GCD inputs are public or masked ....................... PASSED");
+    else { printf("  Binary GCD inputs are public or masked ... FAILED"); printf("\n"); return FAILED; }
+    printf("\n");
+
+    return PASSED;
+}
+
+
+static bool ladders_agree(const point_proj_t R, const point_proj_t S)
+{ // Do R and S have the same x-coordinate? XR*ZS = XS*ZR
+    f2elm_t t0, t1;
+
+    fp2mul964_mont(R->X, S->Z, t0);
+    fp2mul964_mont(S->X, R->Z, t1);
+    fp2correction964(t0);
+    fp2correction964(t1);
+    return memcmp(t0, t1, sizeof(f2elm_t)) == 0;
+}
+
+
+static void ladder_inputs(const unsigned int k, const unsigned int pk, f2elm_t* X, f2elm_t A)
+{ // Basis of key generation (pk = 0) or a public key of the other party (pk = 1) for the ladder of Alice (k = 0) or Bob (k = 1)
+    unsigned char sk[SECRETKEY_A_BYTES + SECRETKEY_B_BYTES], pub[CRYPTO_PUBLICKEYBYTES];
+
+    if (pk == 0) {
+        init_basis((k == 0) ? (digit_t*)A_gen : (digit_t*)B_gen, X[0], X[1], X[2]);
+        fp2zero964(A);
+        return;
+    }
+    if (k == 0) {
+        random_mod_order_B(sk);
+        EphemeralKeyGeneration_B(sk, pub);
+    } else {
+        random_mod_order_A(sk);
+        EphemeralKeyGeneration_A(sk, pub);
+    }
+    fp2_decode(pub, X[0]);
+    fp2_decode(pub + FP2_ENCODED_BYTES, X[1]);
+    fp2_decode(pub + 2*FP2_ENCODED_BYTES, X[2]);
+    get_A(X[0], X[1], X[2], A);
+}
+
+
+int arith_test_ladder()
+{ // Testing and benchmarking the 3-point ladder engines, for the bit lengths of Alice and Bob
+    unsigned int n, k, pk;
+    unsigned long long cycles, cycles1, cycles2;
+    digit_t sk[NWORDS_ORDER] = {0};
+    f2elm_t X[3], A;
+#if defined(_PROJECTIVE_A_)
+    f2elm_t A24plus, C24;
+#endif
+    point_proj_t R, S;
+    static const char* names[2][2] = { { "Alice's ladder, A = 0 ......", "Alice's ladder, A != 0 ....." }, { "Bob's ladder, A = 0 ........", "Bob's ladder, A != 0 ......." } };
+    bool passed = true;
+
+    printf("\n\nTESTING AND BENCHMARKING THE 3-POINT LADDER ENGINES FOR P964\n");
+    printf("--------------------------------------------------------------------------------------------------------\n\n");
+
+    for (k = 0; k < 2; k++) {
+        for (pk = 0; pk < 2; pk++) {
+            ladder_inputs(k, pk, X, A);
+            for (n = 0; n < TEST_LOOPS/100; n++)
+            {
+                if (k == 0) random_mod_order_A((unsigned char*)sk);
+                else        random_mod_order_B((unsigned char*)sk);
+                LADDER3PT_XDBLADD(X[0], X[1], X[2], sk, (k == 0) ? ALICE : BOB, R, A);
+                LADDER3PT_PAIRED(X[0], X[1], X[2], sk, (k == 0) ? ALICE : BOB, S, A);
+                if (ladders_agree(R, S) == false) { passed = false; break; }
+#if defined(_PROJECTIVE_A_)
+                if (pk == 1) {
+                    get_A_proj(X[0], X[1], X[2], A24plus, C24);
+                    fp2add964(C24, C24, C24);
+                    fp2add964(A24plus, C24, A24plus);      // A24plus = A+2C
+                    fp2add964(C24, C24, C24);              // C24 = 4C
+                    LADDER3PT_PROJ(X[0], X[1], X[2], sk, (k == 0) ? ALICE : BOB, S, A24plus, C24);
+                    if (ladders_agree(R, S) == false) { passed = false; break; }
+                }
+#endif
+            }
+        }
+    }
+    if (passed == true) printf("  Ladder engine tests .......................................... PASSED");
+    else { printf("  Ladder engine tests ... FAILED"); printf("\n"); return FAILED; }
+    printf("\n");
+
+    for (k = 0; k < 2; k++) {
+        for (pk = 0; pk < 2; pk++) {
+            ladder_inputs(k, pk, X, A);
+            if (k == 0) random_mod_order_A((unsigned char*)sk);
+            else        random_mod_order_B((unsigned char*)sk);
+
+            cycles = 0;
+            for (n = 0; n < BENCH_LOOPS/100; n++)
+            {
+                cycles1 = cpucycles();
+                LADDER3PT_XDBLADD(X[0], X[1], X[2], sk, (k == 0) ? ALICE : BOB, R, A);
+                cycles2 = cpucycles();
+                cycles = cycles+(cycles2-cycles1);
+            }
+            printf("  %s XDBLADD runs in ............... %10lld ", names[k][pk], cycles/(BENCH_LOOPS/100)); print_unit;
+            printf("\n");
+
+            cycles = 0;
+            for (n = 0; n < BENCH_LOOPS/100; n++)
+            {
+                cycles1 = cpucycles();
+                LADDER3PT_PAIRED(X[0], X[1], X[2], sk, (k == 0) ? ALICE : BOB, S, A);
+                cycles2 = cpucycles();
+                cycles = cycles+(cycles2-cycles1);
+            }
+            printf("  %s PAIRED runs in ................ %10lld ", names[k][pk], cycles/(BENCH_LOOPS/100)); print_unit;
+            printf("\n");
+        }
+    }
+
+    return PASSED;
+}
+
+
+#if defined(_FIXED_BASE_)
+
+int arith_test_fixed_base()
+{ // Testing and benchmarking the 3-point ladder with precomputed tables against LADDER3PT
+    unsigned int n, k;
+    unsigned long long cycles, cycles1, cycles2;
+    digit_t sk[NWORDS_ORDER] = {0};
+    f2elm_t XP, XQ, XR, A = {0};
+    point_proj_t R, S;
+    bool passed = true;
+
+    printf("\n\nTESTING THE FIXED-BASE 3-POINT LADDER FOR P964\n");
+    printf("--------------------------------------------------------------------------------------------------------\n\n");
+
+    for (k = 0; k < 2; k++)
+    {
+        init_basis((k == 0) ? (digit_t*)A_gen : (digit_t*)B_gen, XP, XQ, XR);
+        for (n = 0; n < TEST_LOOPS/10; n++)
+        {
+            if (k == 0) random_mod_order_A((unsigned char*)sk);
+            else        random_mod_order_B((unsigned char*)sk);
+            LADDER3PT(XP, XQ, XR, sk, (k == 0) ? ALICE : BOB, R, A);
+            LADDER3PT_KEYGEN(XP, XQ, XR, sk, (k == 0) ? ALICE : BOB, S, A);
+            if (ladders_agree(R, S) == false) { passed = false; break; }
+        }
+    }
+    if (fixed_base_state[0] != 2 || fixed_base_state[1] != 2) passed = false;
+    if (passed == true) printf("  Fixed-base ladder tests ...................................... PASSED");
+    else { printf("  Fixed-base ladder tests ... FAILED"); printf("\n"); return FAILED; }
+    printf("\n");
+
+    init_basis((digit_t*)A_gen, XP, XQ, XR);
+    random_mod_order_A((unsigned char*)sk);
+
+    cycles = 0;
+    for (n = 0; n < BENCH_LOOPS/100; n++)
+    {
+        cycles1 = cpucycles();
+        LADDER3PT(XP, XQ, XR, sk, ALICE, R, A);
+        cycles2 = cpucycles();
+        cycles = cycles+(cycles2-cycles1);
+    }
+    printf("  Alice's 3-point ladder runs in ............................... %10lld ", cycles/(BENCH_LOOPS/100)); print_unit;
+    printf("\n");
+
+    cycles = 0;
+    for (n = 0; n < BENCH_LOOPS/100; n++)
+    {
+        cycles1 = cpucycles();
+        LADDER3PT_KEYGEN(XP, XQ, XR, sk, ALICE, S, A);
+        cycles2 = cpucycles();
+        cycles = cycles+(cycles2-cycles1);
+    }
+    printf("  Alice's fixed-base 3-point ladder runs in .................... %10lld ", cycles/(BENCH_LOOPS/100)); print_unit;
+    printf("\n");
+
+    cycles = 0;
+    for (n = 0; n < BENCH_LOOPS/100; n++)
+    {
+        cycles1 = cpucycles();
+        fixed_base_table(XQ, fixed_base_Alice, OALICE_BITS);
+        cycles2 = cpucycles();
+        cycles = cycles+(cycles2-cycles1);
+    }
+    printf("  Alice's table (once per process) is computed in .............. %10lld ", cycles/(BENCH_LOOPS/100)); print_unit;
+    printf("\n");
+
+    return PASSED;
+}
+
+#endif
+
+
+int arith_test_sqrt()
+{ // Testing the exponentiations against the inversion and the norm, and the square roots and Legendre symbols
+    unsigned int n, squares = 0;
+    felm_t a, b, c, zero = {0};
+    f2elm_t e, f, g;
+    digit_t exponent[NWORDS_FIELD], two[NWORDS_FIELD] = {2}, one[NWORDS_FIELD] = {1};
+    bool passed = true;
+
+    printf("\n\nTESTING EXPONENTIATION AND SQUARE ROOTS OVER GF(p964)\n");
+    printf("--------------------------------------------------------------------------------------------------------\n\n");
+
+    mp_sub((digit_t*)PRIME, two, exponent, NWORDS_FIELD);       // a^(p-2) = a^-1
+    for (n = 0; n < TEST_LOOPS; n++)
+    {
+        fprandom964_test(a);
+        fpexp964_mont(a, exponent, NBITS_FIELD, b);
+        fpcopy964(a, c); fpinv964_mont(c);
+        fpcorrection964(b); fpcorrection964(c);
+        if (memcmp(b, c, sizeof(felm_t)) != 0) { passed = false; break; }
+    }
+    mp_add((digit_t*)PRIME, one, exponent, NWORDS_FIELD);       // a^(p+1) = a0^2+a1^2
+    for (n = 0; n < TEST_LOOPS && passed; n++)
+    {
+        fp2random964_test(e);
+        fp2exp964_mont(e, exponent, NBITS_FIELD, f);
+        fpsqr964_mont(e[0], g[0]); fpsqr964_mont(e[1], g[1]);
+        fpadd964(g[0], g[1], g[0]); fpzero964(g[1]);
+        fp2correction964(f); fp2correction964(g);
+        if (memcmp(f, g, sizeof(f2elm_t)) != 0) { passed = false; break; }
+    }
+    if (passed == true) printf("  GF(p) and GF(p^2) exponentiation tests ....................... PASSED");
+    else { printf("  GF(p) and GF(p^2) exponentiation tests ... FAILED"); printf("\n"); return FAILED; }
+    printf("\n");
+
+    for (n = 0; n < TEST_LOOPS; n++)
+    {
+        fprandom964_test(a);
+        fpsqr964_mont(a, b);
+        if (fp_legendre964(b) != 1) { passed = false; break; }
+        fpsqrt964_mont(b, c);
+        fpsqr964_mont(c, c);
+        fpcorrection964(b); fpcorrection964(c);
+        if (memcmp(b, c, sizeof(felm_t)) != 0) { passed = false; break; }
+        fpneg964(b);                                            // -1 is not a square
+        if (fp_legendre964(b) != -1) { passed = false; break; }
+    }
+    if (fp_legendre964(zero) != 0) passed = false;
+    if (passed == true) printf("  GF(p) square root and Legendre symbol tests .................. PASSED");
+    else { printf("  GF(p) square root and Legendre symbol tests ... FAILED"); printf("\n"); return FAILED; }
+    printf("\n");
+
+    for (n = 0; n < TEST_LOOPS; n++)
+    {
+        fp2random964_test(e);
+        if (n % 8 == 0) fpzero964(e[1]);                        // Every element of GF(p) is a square in GF(p^2)
+        fp2sqrt964(e, f);
+        fp2sqr964_mont(f, g);
+        fp2correction964(e); fp2correction964(g);
+        if ((memcmp(e, g, sizeof(f2elm_t)) == 0) != fp2_is_square964(e)) { passed = false; break; }
+        if (n % 8 == 0 && fp2_is_square964(e) == 0) { passed = false; break; }
+        squares += fp2_is_square964(e);
+
+        fp2sqr964_mont(e, e);
+        fp2sqrt964(e, f);
+        fp2sqr964_mont(f, g);
+        fp2correction964(e); fp2correction964(g);
+        if (memcmp(e, g, sizeof(f2elm_t)) != 0 || fp2_is_square964(e) == 0) { passed = false; break; }
+    }
+    if (squares == 0 || squares == TEST_LOOPS) passed = false;  // About half of the random elements are squares
+    if (passed == true) printf("  GF(p^2) square root tests .................................... PASSED");
+    else { printf("  GF(p^2) square root tests ... FAILED"); printf("\n"); return FAILED; }
+    printf("\n");
+
+    return PASSED;
+}
+
+
+int arith_run_sqrt()
+{ // Benchmarking the exponentiations, square roots and Legendre symbols
+    unsigned int n;
+    unsigned long long cycles, cycles1, cycles2;
+    felm_t a, b;
+    f2elm_t e, f;
+    digit_t exponent[NWORDS_FIELD], two[NWORDS_FIELD] = {2};
+    int r = 0;
+
+    printf("\n\nBENCHMARKING EXPONENTIATION AND SQUARE ROOTS OVER GF(p964)\n");
+    printf("--------------------------------------------------------------------------------------------------------\n\n");
+
+    fprandom964_test(a);
+    fp2random964_test(e);
+    mp_sub((digit_t*)PRIME, two, exponent, NWORDS_FIELD);
+
+    cycles = 0;
+    for (n = 0; n < BENCH_LOOPS/10; n++)
+    {
+        cycles1 = cpucycles();
+        fpexp964_mont(a, exponent, NBITS_FIELD, b);
+        cycles2 = cpucycles();
+        cycles = cycles+(cycles2-cycles1);
+    }
+    printf("  GF(p) exponentiation (%d-bit exponent) runs in .............. %10lld ", NBITS_FIELD, cycles/(BENCH_LOOPS/10)); print_unit;
+    printf("\n");
+
+    cycles = 0;
+    for (n = 0; n < BENCH_LOOPS/10; n++)
+    {
+        cycles1 = cpucycles();
+        fp2exp964_mont(e, exponent, NBITS_FIELD, f);
+        cycles2 = cpucycles();
+        cycles = cycles+(cycles2-cycles1);
+    }
+    printf("  GF(p^2) exponentiation (%d-bit exponent) runs in ............ %10lld ", NBITS_FIELD, cycles/(BENCH_LOOPS/10)); print_unit;
+    printf("\n");
+
+    cycles = 0;
+    for (n = 0; n < BENCH_LOOPS/10; n++)
+    {
+        cycles1 = cpucycles();
+        fpsqrt964_mont(a, b);
+        cycles2 = cpucycles();
+        cycles = cycles+(cycles2-cycles1);
+    }
+    printf("  GF(p) square root runs in .................................... %10lld ", cycles/(BENCH_LOOPS/10)); print_unit;
+    printf("\n");
+
+    cycles = 0;
+    for (n = 0; n < BENCH_LOOPS/10; n++)
+    {
+        cycles1 = cpucycles();
+        r += fp_legendre964(a);
+        cycles2 = cpucycles();
+        cycles = cycles+(cycles2-cycles1);
+    }
+    printf("  GF(p) Legendre symbol runs in ................................ %10lld ", cycles/(BENCH_LOOPS/10)); print_unit;
+    printf("\n");
+
+    cycles = 0;
+    for (n = 0; n < BENCH_LOOPS/10; n++)
+    {
+        cycles1 = cpucycles();
+        r += fp2_is_square964(e);
+        cycles2 = cpucycles();
+        cycles = cycles+(cycles2-cycles1);
+    }
+    printf("  GF(p^2) square test runs in .................................. %10lld ", cycles/(BENCH_LOOPS/10)); print_unit;
+    printf("\n");
+
+    cycles = 0;
+    for (n = 0; n < BENCH_LOOPS/10; n++)
+    {
+        cycles1 = cpucycles();
+        fp2sqrt964(e, f);
+        cycles2 = cpucycles();
+        cycles = cycles+(cycles2-cycles1);
+    }
+    printf("  GF(p^2) square root runs in .................................. %10lld ", cycles/(BENCH_LOOPS/10)); print_unit;
+    printf("\n");
+
+    return (r == 0x7FFFFFFF) ? FAILED : PASSED;                 // Keeps the results of the loops
+}
+
+
+int main()
+{
+    int Status = PASSED;
+
+    Status = arith_test_x2();              // Test paired multiplications
+    if (Status != PASSED) {
+        printf("\n\n   Error detected: ARITHMETIC ERROR \n\n");
+        return FAILED;
+    }
+
+    Status = arith_run_x2();               // Benchmark paired multiplications
+    if (Status != PASSED) {
+        printf("\n\n   Error detected: ARITHMETIC ERROR \n\n");
+        return FAILED;
+    }
+
+    Status = arith_test_inv();             // Test inversions
+    if (Status != PASSED) {
+        printf("\n\n   Error detected: ARITHMETIC ERROR \n\n");
+        return FAILED;
+    }
+
+    Status = arith_run_inv();              // Benchmark inversions
+    if (Status != PASSED) {
+        printf("\n\n   Error detected: ARITHMETIC ERROR \n\n");
+        return FAILED;
+    }
+
+    Status = arith_test_bingcd();          // Test binary GCD inversions
+    if (Status != PASSED) {
+        printf("\n\n   Error detected: ARITHMETIC ERROR \n\n");
+        return FAILED;
+    }
+
+    Status = arith_test_sqrt();            // Test exponentiation, square roots and Legendre symbols
+    if (Status != PASSED) {
+        printf("\n\n   Error detected: ARITHMETIC ERROR \n\n");
+        return FAILED;
+    }
+
+    Status = arith_run_sqrt();             // Benchmark exponentiation, square roots and Legendre symbols
+    if (Status != PASSED) {
+        printf("\n\n   Error detected: ARITHMETIC ERROR \n\n");
+        return FAILED;
+    }
+
+    Status = arith_test_ladder();          // Test and benchmark the 3-point ladder engines
+    if (Status != PASSED) {
+        printf("\n\n   Error detected: ARITHMETIC ERROR \n\n");
+        return FAILED;
+    }
+
+#if defined(_FIXED_BASE_)
+    Status = arith_test_fixed_base();      // Test and benchmark the fixed-base ladder
+    if (Status != PASSED) {
+        printf("\n\n   Error detected: ARITHMETIC ERROR \n\n");
+        return FAILED;
+    }
+#endif
+
+    return Status;
+}
@@ -8,7 +8,7 @@
 #if (OS_TARGET == OS_WIN)
 //    #include <intrin.h>
 #endif
-#if (OS_TARGET == OS_LINUX) && (TARGET == TARGET_ARM || TARGET == TARGET_ARM64)
+#if (OS_TARGET == OS_LINUX) && (TARGET == TARGET_ARM || TARGET == TARGET_ARM64 || TARGET == TARGET_GENERIC)
     #include <time.h>
 #endif
 #include <stdlib.h>
@@ -25,7 +25,7 @@ int64_t cpucycles(void)
 
     asm volatile ("rdtsc\n\t" : "=a" (lo), "=d"(hi));
     return ((int64_t)lo) | (((int64_t)hi) << 32);
-#elif (OS_TARGET == OS_LINUX) && (TARGET == TARGET_ARM || TARGET == TARGET_ARM64)
+#elif (OS_TARGET == OS_LINUX) && (TARGET == TARGET_ARM || TARGET == TARGET_ARM64 || TARGET == TARGET_GENERIC)
     struct timespec time;
 
     clock_gettime(CLOCK_REALTIME, &time);
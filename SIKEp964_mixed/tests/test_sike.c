@@ -8,6 +8,8 @@
 // Benchmark and test parameters 
 #define BENCH_LOOPS       5       
 #define TEST_LOOPS        5 
+#define BENCH_LOOPS_COMPRESSED    ((BENCH_LOOPS+9)/10)    // The compressed KEM is several times slower
+#define STEP_BUDGET               64                      // Steps per slice of a resumable operation in the benchmark
 
 
 int cryptotest_kem()
@@ -96,6 +98,187 @@ int cryptorun_kem()
 }
 
 
+int cryptotest_kem_compressed()
+{ // Testing KEM with compressed keys
+    unsigned int i;
+    unsigned char sk[CRYPTO_SECRETKEYBYTES_COMPRESSED] = {0};
+    unsigned char pk[CRYPTO_PUBLICKEYBYTES_COMPRESSED] = {0};
+    unsigned char ct[CRYPTO_CIPHERTEXTBYTES_COMPRESSED] = {0};
+    unsigned char ss[CRYPTO_BYTES] = {0};
+    unsigned char ss_[CRYPTO_BYTES] = {0};
+    bool passed = true;
+
+    for (i = 0; i < TEST_LOOPS; i++) 
+    {
+        crypto_kem_keypair_compressed(pk, sk);
+        if (crypto_kem_enc_compressed(ct, ss, pk) != 0) {
+            passed = false;
+            break;
+        }
+        crypto_kem_dec_compressed(ss_, ct, sk);
+        
+        if (memcmp(ss, ss_, CRYPTO_BYTES) != 0) {
+            passed = false;
+            break;
+        }
+    }
+
+    if (passed == true) printf("  KEM tests with compressed keys ............................... PASSED");
+    else { printf("  KEM tests with compressed keys ... FAILED"); printf("\n"); return FAILED; }
+    printf("\n"); 
+
+    return PASSED;
+}
+
+
+int cryptorun_kem_compressed()
+{ // Benchmarking key encapsulation with compressed keys
+    unsigned int n;
+    unsigned char sk[CRYPTO_SECRETKEYBYTES_COMPRESSED] = {0};
+    unsigned char pk[CRYPTO_PUBLICKEYBYTES_COMPRESSED] = {0};
+    unsigned char ct[CRYPTO_CIPHERTEXTBYTES_COMPRESSED] = {0};
+    unsigned char ss[CRYPTO_BYTES] = {0};
+    unsigned char ss_[CRYPTO_BYTES] = {0};
+    unsigned long long cycles, cycles1, cycles2;
+
+    printf("\n\nBENCHMARKING ISOGENY-BASED KEY ENCAPSULATION MECHANISM %s WITH COMPRESSED KEYS\n", SCHEME_NAME);
+    printf("--------------------------------------------------------------------------------------------------------\n\n");
+
+    // Benchmarking key generation
+    cycles = 0;
+    for (n = 0; n < BENCH_LOOPS_COMPRESSED; n++)
+    {
+        cycles1 = cpucycles();
+        crypto_kem_keypair_compressed(pk, sk);
+        cycles2 = cpucycles();
+        cycles = cycles+(cycles2-cycles1);
+    }
+    printf("  Key generation runs in ....................................... %10lld ", cycles/BENCH_LOOPS_COMPRESSED); print_unit;
+    printf("\n");
+
+    // Benchmarking encapsulation
+    cycles = 0;
+    for (n = 0; n < BENCH_LOOPS_COMPRESSED; n++)
+    {
+        cycles1 = cpucycles();
+        crypto_kem_enc_compressed(ct, ss, pk);
+        cycles2 = cpucycles();
+        cycles = cycles+(cycles2-cycles1);
+    }
+    printf("  Encapsulation runs in ........................................ %10lld ", cycles/BENCH_LOOPS_COMPRESSED); print_unit;
+    printf("\n");
+
+    // Benchmarking decapsulation
+    cycles = 0;
+    for (n = 0; n < BENCH_LOOPS_COMPRESSED; n++)
+    {
+        cycles1 = cpucycles();
+        crypto_kem_dec_compressed(ss_, ct, sk);   
+        cycles2 = cpucycles();
+        cycles = cycles+(cycles2-cycles1);
+    }
+    printf("  Decapsulation runs in ........................................ %10lld ", cycles/BENCH_LOOPS_COMPRESSED); print_unit;
+    printf("\n");
+
+    return PASSED;
+}
+
+
+int cryptotest_kem_step()
+{ // Testing resumable KEM
+    unsigned int i, n, steps = 0;
+    unsigned char sk[CRYPTO_SECRETKEYBYTES] = {0};
+    unsigned char pk[CRYPTO_PUBLICKEYBYTES] = {0};
+    unsigned char ct[CRYPTO_CIPHERTEXTBYTES] = {0};
+    unsigned char ss[CRYPTO_BYTES] = {0};
+    unsigned char ss_[CRYPTO_BYTES] = {0};
+    sike_op_t op;
+    bool passed = true;
+
+    for (i = 0; i < TEST_LOOPS; i++) 
+    {
+        // Key pair one step at a time, the number of steps is the same for every key
+        sike_op_init_keypair(&op, pk, sk);
+        for (n = 1; sike_op_step(&op, 1) == 0; n++);
+        if (sike_op_done(&op) != 0 || (i > 0 && n != steps)) passed = false;
+        steps = n;
+
+        // Resumable encapsulation in slices of different sizes against the KEM's decapsulation, and the other way round
+        sike_op_init_enc(&op, ct, ss, pk);
+        while (sike_op_step(&op, 7*i+1) == 0);
+        if (sike_op_done(&op) != 0) passed = false;
+        crypto_kem_dec(ss_, ct, sk);
+        if (memcmp(ss, ss_, CRYPTO_BYTES) != 0) passed = false;
+
+        crypto_kem_enc(ct, ss, pk);
+        sike_op_init_dec(&op, ss_, ct, sk);
+        while (sike_op_step(&op, 100*i+1) == 0);
+        if (sike_op_done(&op) != 0) passed = false;
+        if (memcmp(ss, ss_, CRYPTO_BYTES) != 0) passed = false;
+    }
+
+    // A malformed ciphertext, and an operation ended before it is complete
+    ct[0] ^= 1;
+    sike_op_init_dec(&op, ss_, ct, sk);
+    while (sike_op_step(&op, 1000) == 0);
+    sike_op_done(&op);
+    if (memcmp(ss, ss_, CRYPTO_BYTES) == 0) passed = false;
+    sike_op_init_enc(&op, ct, ss, pk);
+    if (sike_op_step(&op, 10) != 0 || sike_op_done(&op) != -1) passed = false;
+
+    if (passed == true) printf("  KEM tests with resumable operations .......................... PASSED");
+    else { printf("  KEM tests with resumable operations ... FAILED"); printf("\n"); return FAILED; }
+    printf("\n");
+
+    return PASSED;
+}
+
+
+static void cryptorun_op_step(const char* name, sike_op_t* op)
+{ // Runs an operation in slices of STEP_BUDGET steps, prints its total time and its longest slice
+    unsigned long long cycles, cycles1, cycles2, longest = 0, total = 0;
+    unsigned int slices = 0;
+    int done;
+
+    do {
+        cycles1 = cpucycles();
+        done = sike_op_step(op, STEP_BUDGET);
+        cycles2 = cpucycles();
+        cycles = cycles2-cycles1;
+        total += cycles;
+        if (cycles > longest) longest = cycles;
+        slices++;
+    } while (done == 0);
+    sike_op_done(op);
+
+    printf("  %-14s runs in .................. %10lld ", name, total); print_unit;
+    printf(", %5u slices, the longest in %10lld ", slices, longest); print_unit;
+    printf("\n");
+}
+
+
+int cryptorun_kem_step()
+{ // Benchmarking resumable key encapsulation
+    unsigned char sk[CRYPTO_SECRETKEYBYTES] = {0};
+    unsigned char pk[CRYPTO_PUBLICKEYBYTES] = {0};
+    unsigned char ct[CRYPTO_CIPHERTEXTBYTES] = {0};
+    unsigned char ss[CRYPTO_BYTES] = {0};
+    sike_op_t op;
+
+    printf("\n\nBENCHMARKING ISOGENY-BASED KEY ENCAPSULATION MECHANISM %s IN SLICES OF %d STEPS\n", SCHEME_NAME, STEP_BUDGET);
+    printf("--------------------------------------------------------------------------------------------------------\n\n");
+
+    sike_op_init_keypair(&op, pk, sk);
+    cryptorun_op_step("Key generation", &op);
+    sike_op_init_enc(&op, ct, ss, pk);
+    cryptorun_op_step("Encapsulation", &op);
+    sike_op_init_dec(&op, ss, ct, sk);
+    cryptorun_op_step("Decapsulation", &op);
+
+    return PASSED;
+}
+
+
 int main()
 {
     int Status = PASSED;
@@ -106,11 +289,35 @@ int main()
         return FAILED;
     }
 
+    Status = cryptotest_kem_compressed();  // Test key encapsulation mechanism with compressed keys
+    if (Status != PASSED) {
+        printf("\n\n   Error detected: KEM_ERROR_SHARED_KEY \n\n");
+        return FAILED;
+    }
+
+    Status = cryptotest_kem_step();        // Test key encapsulation mechanism with resumable operations
+    if (Status != PASSED) {
+        printf("\n\n   Error detected: KEM_ERROR_SHARED_KEY \n\n");
+        return FAILED;
+    }
+
     Status = cryptorun_kem();              // Benchmark key encapsulation mechanism
     if (Status != PASSED) {
         printf("\n\n   Error detected: KEM_ERROR_SHARED_KEY \n\n");
         return FAILED;
     }
 
+    Status = cryptorun_kem_compressed();   // Benchmark key encapsulation mechanism with compressed keys
+    if (Status != PASSED) {
+        printf("\n\n   Error detected: KEM_ERROR_SHARED_KEY \n\n");
+        return FAILED;
+    }
+
+    Status = cryptorun_kem_step();         // Benchmark key encapsulation mechanism with resumable operations
+    if (Status != PASSED) {
+        printf("\n\n   Error detected: KEM_ERROR_SHARED_KEY \n\n");
+        return FAILED;
+    }
+
     return Status;
 }
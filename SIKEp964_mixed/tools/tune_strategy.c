@@ -0,0 +1,89 @@
+/********************************************************************************************
+* Supersingular Isogeny Key Encapsulation Library
+*
+* Abstract: measuring the curve and isogeny functions of the tree traversal for P964 on this machine.
+*           Prints the costs of xDBL, xTPL, get_4_isog, eval_4_isog, get_3_isog and eval_3_isog in the
+*           order of "gen_strategy -c", see "make tune".
+*********************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "../P964_internal.h"
+#include "../P964.c"
+#include "../random/random.h"
+#include "../tests/test_extras.h"
+
+
+#define TUNE_LOOPS        1000
+#define TUNE_ROUNDS       9                     // The cost is the median of the rounds
+
+#define TUNE_OPS          6
+static const char* tune_names[TUNE_OPS] = { "xDBL", "xTPL", "get_4_isog", "eval_4_isog", "get_3_isog", "eval_3_isog" };
+
+
+static void fp2random964_tune(felm_t* a)
+{ // Generating a pseudo-random element in GF(p964^2)
+    unsigned int i;
+
+    for (i = 0; i < 2; i++) {
+        randombytes((unsigned char*)a[i], NWORDS_FIELD*sizeof(digit_t));
+        a[i][NWORDS_FIELD-1] %= p964[NWORDS64_FIELD-1];
+    }
+}
+
+
+static int compare_cycles(const void* a, const void* b)
+{
+    int64_t x = *(const int64_t*)a, y = *(const int64_t*)b;
+    return (x > y) - (x < y);
+}
+
+
+static double tune_op(unsigned int op)
+{ // Median over TUNE_ROUNDS of the cost of one call
+    point_proj_t P, Q;
+    f2elm_t A24plus, C24, coeff[3];
+    int64_t t[TUNE_ROUNDS], cycles;
+    unsigned int r, n;
+
+    fp2random964_tune(P->X);
+    fp2random964_tune(P->Z);
+    fp2random964_tune(A24plus);
+    fp2random964_tune(C24);
+    fp2random964_tune(coeff[0]);
+    fp2random964_tune(coeff[1]);
+    fp2random964_tune(coeff[2]);
+
+    for (r = 0; r < TUNE_ROUNDS; r++) {
+        cycles = cpucycles();
+        for (n = 0; n < TUNE_LOOPS; n++) {
+            switch (op) {
+                case 0:  xDBL(P, Q, A24plus, C24); break;
+                case 1:  xTPL(P, Q, A24plus, C24); break;
+                case 2:  get_4_isog(P, A24plus, C24, coeff); break;
+                case 3:  eval_4_isog(P, coeff); break;
+                case 4:  get_3_isog(P, A24plus, C24, coeff); break;
+                default: eval_3_isog(P, coeff); break;
+            }
+        }
+        t[r] = cpucycles() - cycles;
+    }
+    qsort(t, TUNE_ROUNDS, sizeof(int64_t), compare_cycles);
+    return (double)t[TUNE_ROUNDS/2]/TUNE_LOOPS;
+}
+
+
+int main()
+{
+    double cost[TUNE_OPS];
+    unsigned int i;
+
+    for (i = 0; i < TUNE_OPS; i++) {
+        cost[i] = tune_op(i);
+        fprintf(stderr, "  %-12s %10.1f %s\n", tune_names[i], cost[i], (TARGET == TARGET_AMD64) ? "cycles" : "nsec");
+    }
+    for (i = 0; i < TUNE_OPS; i++) {
+        printf("%.1f%s", cost[i], (i < TUNE_OPS-1) ? " " : "\n");
+    }
+    return 0;
+}
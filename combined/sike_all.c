@@ -0,0 +1,39 @@
+/********************************************************************************************
+* Supersingular Isogeny Key Encapsulation Library
+*
+* Abstract: dispatch table of the combined library
+*********************************************************************************************/
+
+#include <string.h>
+#include "sike_all.h"
+
+
+#define SIKE_KEM_ENTRY(name, algname, prefix, P)                                   \
+    { name, algname, SIKE_##P##_SECRETKEYBYTES, SIKE_##P##_PUBLICKEYBYTES,         \
+      SIKE_##P##_CIPHERTEXTBYTES, SIKE_##P##_BYTES,                                \
+      prefix##_kem_keypair, prefix##_kem_enc, prefix##_kem_dec }
+
+// For each parameter set the default variant comes first
+const sike_kem_t sike_kems[] = {
+    SIKE_KEM_ENTRY("SIKEp503_mixed", "SIKEp503", sike_p503_mixed, P503),
+    SIKE_KEM_ENTRY("SIKEp503_gpr",   "SIKEp503", sike_p503,       P503),
+    SIKE_KEM_ENTRY("SIKEp751_mixed", "SIKEp751", sike_p751_mixed, P751),
+    SIKE_KEM_ENTRY("SIKEp751_gpr",   "SIKEp751", sike_p751,       P751),
+    SIKE_KEM_ENTRY("SIKEp964_mixed", "SIKEp964", sike_p964_mixed, P964),
+};
+
+const unsigned int sike_kems_count = sizeof(sike_kems)/sizeof(sike_kems[0]);
+
+
+const sike_kem_t *sike_kem_get(const char *name)
+{ // Variant with the given name, or the default variant of the parameter set with the given name
+    unsigned int i;
+
+    for (i = 0; i < sike_kems_count; i++) {
+        if (strcmp(sike_kems[i].name, name) == 0) return &sike_kems[i];
+    }
+    for (i = 0; i < sike_kems_count; i++) {
+        if (strcmp(sike_kems[i].algname, name) == 0) return &sike_kems[i];
+    }
+    return NULL;
+}
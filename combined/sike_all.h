@@ -0,0 +1,126 @@
+/********************************************************************************************
+* Supersingular Isogeny Key Encapsulation Library
+*
+* Abstract: API header file for the combined library with all the parameter sets
+*********************************************************************************************/
+
+#ifndef __SIKE_ALL_H__
+#define __SIKE_ALL_H__
+
+
+/*********************** Sizes of the parameter sets ***********************/
+// These are CRYPTO_SECRETKEYBYTES, CRYPTO_PUBLICKEYBYTES, CRYPTO_CIPHERTEXTBYTES and CRYPTO_BYTES
+// of api.h in the directory of each parameter set. The GPR-only and mixed variants share them.
+
+#define SIKE_P503_SECRETKEYBYTES     434
+#define SIKE_P503_PUBLICKEYBYTES     378
+#define SIKE_P503_CIPHERTEXTBYTES    402
+#define SIKE_P503_BYTES               16
+
+#define SIKE_P751_SECRETKEYBYTES     644
+#define SIKE_P751_PUBLICKEYBYTES     564
+#define SIKE_P751_CIPHERTEXTBYTES    596
+#define SIKE_P751_BYTES               24
+
+#define SIKE_P964_SECRETKEYBYTES     826
+#define SIKE_P964_PUBLICKEYBYTES     726
+#define SIKE_P964_CIPHERTEXTBYTES    766
+#define SIKE_P964_BYTES               32
+
+// Largest sizes over all the parameter sets, for buffers that serve any of them
+#define SIKE_MAX_SECRETKEYBYTES      SIKE_P964_SECRETKEYBYTES
+#define SIKE_MAX_PUBLICKEYBYTES      SIKE_P964_PUBLICKEYBYTES
+#define SIKE_MAX_CIPHERTEXTBYTES     SIKE_P964_CIPHERTEXTBYTES
+#define SIKE_MAX_BYTES               SIKE_P964_BYTES
+
+
+/*********************** Prefixed entry points ***********************/
+// sike_<variant>_kem_keypair/enc/dec are crypto_kem_keypair/enc/dec of the directory SIKE<variant>,
+// e.g., sike_p751_mixed_kem_enc is crypto_kem_enc of SIKEp751_mixed. All the other symbols of a
+// variant are local to it, so that any number of variants can be linked in the same program.
+
+#define SIKE_KEM_PROTOTYPES(prefix)                                                           \
+    int prefix##_kem_keypair(unsigned char *pk, unsigned char *sk);                          \
+    int prefix##_kem_enc(unsigned char *ct, unsigned char *ss, const unsigned char *pk);     \
+    int prefix##_kem_dec(unsigned char *ss, const unsigned char *ct, const unsigned char *sk);
+
+SIKE_KEM_PROTOTYPES(sike_p503)
+SIKE_KEM_PROTOTYPES(sike_p503_mixed)
+SIKE_KEM_PROTOTYPES(sike_p751)
+SIKE_KEM_PROTOTYPES(sike_p751_mixed)
+SIKE_KEM_PROTOTYPES(sike_p964_mixed)
+
+
+/*********************** Dispatch table ***********************/
+
+typedef struct {
+    const char *name;                    // Variant, "SIKEp751_mixed" for SIKEp751_mixed and "SIKEp751_gpr" for SIKEp751
+    const char *algname;                 // Parameter set, CRYPTO_ALGNAME of the variant, e.g., "SIKEp751"
+    unsigned int secretkey_bytes;
+    unsigned int publickey_bytes;
+    unsigned int ciphertext_bytes;
+    unsigned int shared_secret_bytes;
+    int (*keypair)(unsigned char *pk, unsigned char *sk);
+    int (*enc)(unsigned char *ct, unsigned char *ss, const unsigned char *pk);
+    int (*dec)(unsigned char *ss, const unsigned char *ct, const unsigned char *sk);
+} sike_kem_t;
+
+// All the variants in the library. The variants of one parameter set interoperate: a key pair
+// generated by one of them works with the encapsulation and decapsulation of any other one.
+extern const sike_kem_t sike_kems[];
+extern const unsigned int sike_kems_count;
+
+// Returns the variant with the given name (e.g., "SIKEp503_gpr" or "SIKEp503_mixed"), or NULL.
+// A parameter set name (e.g., "SIKEp503") returns its default variant, the mixed one.
+const sike_kem_t *sike_kem_get(const char *name);
+
+
+/*********************** Job engine ***********************/
+// A pool of worker threads that runs keypair, enc and dec jobs of any variant, with one deque of jobs per worker.
+// Workers take their own jobs first and steal the jobs of other workers when they run out, so that a stream of
+// operations with different costs keeps all the workers busy. Jobs are completed by their callback, called on
+// the worker thread, or queued for sike_engine_wait and sike_engine_poll if they have none.
+
+typedef enum { SIKE_JOB_KEYPAIR, SIKE_JOB_ENC, SIKE_JOB_DEC } sike_job_op_t;
+
+typedef struct sike_job {
+    const sike_kem_t *kem;               // Variant, e.g., from sike_kem_get
+    sike_job_op_t op;
+    unsigned char *pk;                   // Output of SIKE_JOB_KEYPAIR, input of SIKE_JOB_ENC
+    unsigned char *sk;                   // Output of SIKE_JOB_KEYPAIR, input of SIKE_JOB_DEC
+    unsigned char *ct;                   // Output of SIKE_JOB_ENC, input of SIKE_JOB_DEC
+    unsigned char *ss;                   // Output of SIKE_JOB_ENC and SIKE_JOB_DEC
+    int result;                          // Return value of the KEM function
+    void (*callback)(struct sike_job *job);    // Called when the job is done, NULL to queue it for sike_engine_wait/poll
+    void *arg;                           // For the caller
+    struct sike_job *next;               // Used by the engine
+} sike_job_t;
+
+typedef struct sike_engine sike_engine_t;
+
+// Starts an engine with nthreads worker threads, one per core the calling thread may run on with nthreads = 0. With
+// pin != 0 the i-th worker is bound to the i-th of these cores, modulo their number (Linux only). Returns NULL on
+// failure, including when a worker cannot be pinned.
+sike_engine_t *sike_engine_create(unsigned int nthreads, int pin);
+
+// Returns the number of workers of the engine, e.g., the number of cores it found with nthreads = 0.
+unsigned int sike_engine_workers(const sike_engine_t *engine);
+
+// Submits a job, from any thread or from a callback. The job and its buffers must stay valid until it is completed.
+// Returns 0, or -1 if job->kem is NULL or the engine is being destroyed.
+int sike_engine_submit(sike_engine_t *engine, sike_job_t *job);
+
+// Returns the next completed job without callback, waiting for one while submitted jobs are not completed (their
+// callbacks may submit more jobs), or NULL once all the jobs are completed. Not to be called from a callback.
+sike_job_t *sike_engine_wait(sike_engine_t *engine);
+
+// Returns the next completed job without callback, or NULL if none has completed.
+sike_job_t *sike_engine_poll(sike_engine_t *engine);
+
+// Waits for all the submitted jobs, including the ones submitted by callbacks meanwhile, stops the workers and
+// frees the engine. Completed jobs that were not returned by sike_engine_wait/poll are dropped. Not to be called
+// from a callback.
+void sike_engine_destroy(sike_engine_t *engine);
+
+
+#endif
@@ -0,0 +1,394 @@
+/********************************************************************************************
+* Supersingular Isogeny Key Encapsulation Library
+*
+* Abstract: job engine of the combined library, a work-stealing thread pool for KEM operations
+*********************************************************************************************/
+
+#define _GNU_SOURCE
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "sike_all.h"
+
+
+#define ENGINE_DEQUE_SIZE    256           // Jobs per worker deque, a power of 2
+#define ENGINE_GRAB          4             // Jobs a worker takes at once from the submission queue
+#define ENGINE_MAX_THREADS   1024
+
+typedef struct {                           // Chase-Lev deque: its worker pushes and pops at the bottom, the other workers steal at the top
+    int64_t top;
+    char pad[64 - sizeof(int64_t)];        // top and bottom on different cache lines
+    int64_t bottom;
+    sike_job_t *jobs[ENGINE_DEQUE_SIZE];
+} job_deque_t;
+
+typedef struct {
+    job_deque_t deque;
+    sike_engine_t *engine;
+    unsigned int seed;                     // For the choice of the victims of steals
+    pthread_t thread;
+} engine_worker_t;
+
+struct sike_engine {
+    engine_worker_t *workers;
+    unsigned int nworkers;
+    unsigned int queued;                   // Jobs in the deques and the submission queue, updated atomically
+    unsigned int outstanding;              // Jobs submitted and not completed, updated atomically
+    unsigned int sleepers;                 // Workers waiting for work, updated atomically under the lock
+    unsigned int waiters;                  // Threads waiting for done, updated atomically under the lock
+    pthread_mutex_t lock;                  // Protects the fields below
+    pthread_cond_t work;                   // Signaled when jobs are queued and when the engine stops
+    pthread_cond_t done;                   // Signaled when jobs complete
+    sike_job_t *submitted_head, *submitted_tail;    // Jobs submitted by other threads than the workers
+    sike_job_t *completed_head, *completed_tail;    // Completed jobs without callback
+    int stop;
+};
+
+static __thread engine_worker_t *engine_self = NULL;    // Worker of the calling thread, NULL outside of the workers
+
+
+static int deque_push(job_deque_t *d, sike_job_t *job)
+{ // Pushes a job at the bottom, only called by the worker of the deque. Returns -1 if the deque is full
+    int64_t b = __atomic_load_n(&d->bottom, __ATOMIC_RELAXED);
+    int64_t t = __atomic_load_n(&d->top, __ATOMIC_ACQUIRE);
+
+    if (b - t >= ENGINE_DEQUE_SIZE) return -1;
+    __atomic_store_n(&d->jobs[b & (ENGINE_DEQUE_SIZE-1)], job, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    __atomic_store_n(&d->bottom, b + 1, __ATOMIC_RELAXED);
+    return 0;
+}
+
+
+static sike_job_t *deque_pop(job_deque_t *d)
+{ // Pops the job at the bottom, only called by the worker of the deque. The last job is claimed against the thieves with compare-and-swap
+    int64_t b = __atomic_load_n(&d->bottom, __ATOMIC_RELAXED) - 1;
+    int64_t t;
+    sike_job_t *job = NULL;
+
+    __atomic_store_n(&d->bottom, b, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    t = __atomic_load_n(&d->top, __ATOMIC_RELAXED);
+    if (t <= b) {
+        job = __atomic_load_n(&d->jobs[b & (ENGINE_DEQUE_SIZE-1)], __ATOMIC_RELAXED);
+        if (t == b) {
+            if (!__atomic_compare_exchange_n(&d->top, &t, t + 1, 0, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED)) job = NULL;
+            __atomic_store_n(&d->bottom, b + 1, __ATOMIC_RELAXED);
+        }
+    } else {
+        __atomic_store_n(&d->bottom, b + 1, __ATOMIC_RELAXED);
+    }
+    return job;
+}
+
+
+static sike_job_t *deque_steal(job_deque_t *d)
+{ // Steals the job at the top, NULL if the deque is empty or another thread took the job first
+    int64_t t = __atomic_load_n(&d->top, __ATOMIC_ACQUIRE);
+    int64_t b;
+    sike_job_t *job;
+
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    b = __atomic_load_n(&d->bottom, __ATOMIC_ACQUIRE);
+    if (t >= b) return NULL;
+    job = __atomic_load_n(&d->jobs[t & (ENGINE_DEQUE_SIZE-1)], __ATOMIC_RELAXED);
+    if (!__atomic_compare_exchange_n(&d->top, &t, t + 1, 0, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED)) return NULL;
+    return job;
+}
+
+
+static sike_job_t *engine_take_submitted(sike_engine_t *engine, engine_worker_t *self)
+{ // Takes the oldest submitted job and moves the next ENGINE_GRAB-1 ones to the deque of the worker, where idle workers can steal them
+    sike_job_t *job, *next;
+    unsigned int i;
+
+    pthread_mutex_lock(&engine->lock);
+    job = engine->submitted_head;
+    if (job != NULL) {
+        next = job->next;
+        for (i = 1; i < ENGINE_GRAB && next != NULL && deque_push(&self->deque, next) == 0; i++) {
+            next = next->next;
+        }
+        engine->submitted_head = next;
+        if (next == NULL) engine->submitted_tail = NULL;
+        if (i > 1 && __atomic_load_n(&engine->sleepers, __ATOMIC_SEQ_CST) > 0) pthread_cond_signal(&engine->work);
+    }
+    pthread_mutex_unlock(&engine->lock);
+    return job;
+}
+
+
+static sike_job_t *engine_steal(sike_engine_t *engine, engine_worker_t *self)
+{ // Tries to steal a job from every other worker once, starting at a random one
+    unsigned int i, start;
+    sike_job_t *job;
+
+    if (engine->nworkers == 1) return NULL;
+    self->seed = self->seed*1103515245 + 12345;
+    start = (self->seed >> 16) % engine->nworkers;
+    for (i = 0; i < engine->nworkers; i++) {
+        engine_worker_t *victim = &engine->workers[(start + i) % engine->nworkers];
+        if (victim == self) continue;
+        job = deque_steal(&victim->deque);
+        if (job != NULL) return job;
+    }
+    return NULL;
+}
+
+
+static void engine_run(sike_engine_t *engine, sike_job_t *job)
+{ // Runs a job and completes it. A job with callback only takes the lock when it is the last outstanding one and a thread waits
+    const sike_kem_t *kem = job->kem;
+
+    switch (job->op) {
+        case SIKE_JOB_KEYPAIR: job->result = kem->keypair(job->pk, job->sk); break;
+        case SIKE_JOB_ENC:     job->result = kem->enc(job->ct, job->ss, job->pk); break;
+        case SIKE_JOB_DEC:     job->result = kem->dec(job->ss, job->ct, job->sk); break;
+        default:               job->result = -1; break;
+    }
+
+    if (job->callback != NULL) {
+        job->callback(job);                // The job may be reused or freed by the callback
+        // Waiters count themselves before they read outstanding, so one of the two sides sees the other
+        if (__atomic_sub_fetch(&engine->outstanding, 1, __ATOMIC_SEQ_CST) == 0 && __atomic_load_n(&engine->waiters, __ATOMIC_SEQ_CST) > 0) {
+            pthread_mutex_lock(&engine->lock);
+            pthread_cond_broadcast(&engine->done);
+            pthread_mutex_unlock(&engine->lock);
+        }
+    } else {
+        pthread_mutex_lock(&engine->lock);
+        job->next = NULL;
+        if (engine->completed_tail != NULL) engine->completed_tail->next = job;
+        else engine->completed_head = job;
+        engine->completed_tail = job;
+        __atomic_sub_fetch(&engine->outstanding, 1, __ATOMIC_SEQ_CST);
+        if (engine->waiters > 0) pthread_cond_broadcast(&engine->done);
+        pthread_mutex_unlock(&engine->lock);
+    }
+}
+
+
+static void engine_wait_done(sike_engine_t *engine)
+{ // Waits for a completed job without callback or for the last outstanding job, called with the lock held
+    while (engine->completed_head == NULL) {
+        __atomic_add_fetch(&engine->waiters, 1, __ATOMIC_SEQ_CST);
+        if (__atomic_load_n(&engine->outstanding, __ATOMIC_SEQ_CST) == 0) {
+            __atomic_sub_fetch(&engine->waiters, 1, __ATOMIC_SEQ_CST);
+            break;
+        }
+        pthread_cond_wait(&engine->done, &engine->lock);
+        __atomic_sub_fetch(&engine->waiters, 1, __ATOMIC_SEQ_CST);
+    }
+}
+
+
+static void *engine_worker(void *arg)
+{
+    engine_worker_t *self = (engine_worker_t*)arg;
+    sike_engine_t *engine = self->engine;
+    sike_job_t *job;
+
+    engine_self = self;
+
+    for (;;) {
+        job = deque_pop(&self->deque);
+        if (job == NULL) job = engine_take_submitted(engine, self);
+        if (job == NULL) job = engine_steal(engine, self);
+        if (job != NULL) {
+            __atomic_fetch_sub(&engine->queued, 1, __ATOMIC_RELAXED);
+            engine_run(engine, job);
+            continue;
+        }
+
+        // A worker counts itself as a sleeper before it reads queued, and a submitter counts the job in queued before it
+        // reads sleepers, so either the worker sees the job or the submitter signals it under the lock
+        pthread_mutex_lock(&engine->lock);
+        while (!engine->stop) {
+            __atomic_add_fetch(&engine->sleepers, 1, __ATOMIC_SEQ_CST);
+            if (__atomic_load_n(&engine->queued, __ATOMIC_SEQ_CST) != 0) {
+                __atomic_sub_fetch(&engine->sleepers, 1, __ATOMIC_SEQ_CST);
+                break;
+            }
+            pthread_cond_wait(&engine->work, &engine->lock);
+            __atomic_sub_fetch(&engine->sleepers, 1, __ATOMIC_SEQ_CST);
+        }
+        if (engine->stop) {
+            pthread_mutex_unlock(&engine->lock);
+            break;
+        }
+        pthread_mutex_unlock(&engine->lock);
+        sched_yield();                     // The queued jobs are being taken by other workers
+    }
+    return NULL;
+}
+
+
+sike_engine_t *sike_engine_create(unsigned int nthreads, int pin)
+{ // Starts an engine with nthreads workers, one per core available to the calling thread if nthreads = 0
+    sike_engine_t *engine;
+    pthread_attr_t attr;
+    unsigned int i;
+    int status = 0;
+#if defined(__LINUX__)
+    cpu_set_t allowed, cpus;
+    int cpu[CPU_SETSIZE], ncpus = 0;
+
+    // The i-th worker runs on the i-th core of the affinity mask of the calling thread, e.g., of a container or taskset
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) == 0) {
+        for (i = 0; i < CPU_SETSIZE; i++) {
+            if (CPU_ISSET(i, &allowed)) cpu[ncpus++] = i;
+        }
+    }
+    if (pin && ncpus == 0) return NULL;
+    if (nthreads == 0) nthreads = (unsigned int)ncpus;
+#else
+    (void)pin;
+#endif
+    if (nthreads == 0) {
+        long n = sysconf(_SC_NPROCESSORS_ONLN);
+        nthreads = (n > 0) ? (unsigned int)n : 1;
+    }
+    if (nthreads > ENGINE_MAX_THREADS) nthreads = ENGINE_MAX_THREADS;
+
+    engine = (sike_engine_t*)calloc(1, sizeof(sike_engine_t));
+    if (engine == NULL) return NULL;
+    engine->workers = (engine_worker_t*)calloc(nthreads, sizeof(engine_worker_t));
+    if (engine->workers == NULL) {
+        free(engine);
+        return NULL;
+    }
+    pthread_mutex_init(&engine->lock, NULL);
+    pthread_cond_init(&engine->work, NULL);
+    pthread_cond_init(&engine->done, NULL);
+
+    for (i = 0; i < nthreads; i++) {
+        engine->workers[i].engine = engine;
+        engine->workers[i].seed = i + 1;
+    }
+    // Workers only steal from the first nworkers workers, so nworkers is set before they start
+    engine->nworkers = nthreads;
+    for (i = 0; i < nthreads; i++) {
+        pthread_attr_init(&attr);
+#if defined(__LINUX__)
+        if (pin) {                         // A worker that cannot be pinned fails the creation of the engine
+            CPU_ZERO(&cpus);
+            CPU_SET(cpu[i % ncpus], &cpus);
+            status = pthread_attr_setaffinity_np(&attr, sizeof(cpus), &cpus);
+        }
+#endif
+        if (status == 0) status = pthread_create(&engine->workers[i].thread, &attr, engine_worker, &engine->workers[i]);
+        pthread_attr_destroy(&attr);
+        if (status != 0) break;
+    }
+    if (i < nthreads) {
+        engine->nworkers = i;              // Steals from workers that never started find their deques empty
+        sike_engine_destroy(engine);
+        return NULL;
+    }
+    return engine;
+}
+
+
+unsigned int sike_engine_workers(const sike_engine_t *engine)
+{ // Number of workers, fixed at the creation of the engine
+    return engine->nworkers;
+}
+
+
+int sike_engine_submit(sike_engine_t *engine, sike_job_t *job)
+{ // Queues a job, in the deque of the calling worker without taking the lock when called from a callback
+    if (job == NULL || job->kem == NULL) return -1;
+
+    job->next = NULL;
+    if (engine_self != NULL && engine_self->engine == engine) {
+        // The job of the callback is still outstanding, so the engine cannot be stopping
+        __atomic_add_fetch(&engine->outstanding, 1, __ATOMIC_SEQ_CST);
+        if (deque_push(&engine_self->deque, job) == 0) {
+            __atomic_add_fetch(&engine->queued, 1, __ATOMIC_SEQ_CST);
+            if (__atomic_load_n(&engine->sleepers, __ATOMIC_SEQ_CST) > 0) {
+                pthread_mutex_lock(&engine->lock);
+                pthread_cond_signal(&engine->work);
+                pthread_mutex_unlock(&engine->lock);
+            }
+            return 0;
+        }
+        pthread_mutex_lock(&engine->lock);  // The deque is full
+    } else {
+        pthread_mutex_lock(&engine->lock);
+        if (engine->stop) {
+            pthread_mutex_unlock(&engine->lock);
+            return -1;
+        }
+        __atomic_add_fetch(&engine->outstanding, 1, __ATOMIC_SEQ_CST);
+    }
+    if (engine->submitted_tail != NULL) engine->submitted_tail->next = job;
+    else engine->submitted_head = job;
+    engine->submitted_tail = job;
+    __atomic_add_fetch(&engine->queued, 1, __ATOMIC_SEQ_CST);
+    if (engine->sleepers > 0) pthread_cond_signal(&engine->work);
+    pthread_mutex_unlock(&engine->lock);
+    return 0;
+}
+
+
+static sike_job_t *engine_completed(sike_engine_t *engine)
+{ // Removes the oldest completed job without callback, called with the lock held
+    sike_job_t *job = engine->completed_head;
+
+    if (job != NULL) {
+        engine->completed_head = job->next;
+        if (engine->completed_head == NULL) engine->completed_tail = NULL;
+        job->next = NULL;
+    }
+    return job;
+}
+
+
+sike_job_t *sike_engine_wait(sike_engine_t *engine)
+{ // Next completed job without callback, waits for one while jobs are outstanding. NULL when all the jobs are done
+    sike_job_t *job;
+
+    pthread_mutex_lock(&engine->lock);
+    engine_wait_done(engine);
+    job = engine_completed(engine);
+    pthread_mutex_unlock(&engine->lock);
+    return job;
+}
+
+
+sike_job_t *sike_engine_poll(sike_engine_t *engine)
+{ // Next completed job without callback, NULL if none has completed
+    sike_job_t *job;
+
+    pthread_mutex_lock(&engine->lock);
+    job = engine_completed(engine);
+    pthread_mutex_unlock(&engine->lock);
+    return job;
+}
+
+
+void sike_engine_destroy(sike_engine_t *engine)
+{ // Waits for the submitted jobs, stops the workers and frees the engine
+    unsigned int i;
+
+    if (engine == NULL) return;
+    pthread_mutex_lock(&engine->lock);
+    while (__atomic_load_n(&engine->outstanding, __ATOMIC_SEQ_CST) > 0) {
+        engine_wait_done(engine);
+        engine_completed(engine);          // Dropped, see sike_engine_destroy in sike_all.h
+    }
+    engine->stop = 1;
+    pthread_cond_broadcast(&engine->work);
+    pthread_mutex_unlock(&engine->lock);
+
+    for (i = 0; i < engine->nworkers; i++) {
+        pthread_join(engine->workers[i].thread, NULL);
+    }
+    pthread_mutex_destroy(&engine->lock);
+    pthread_cond_destroy(&engine->work);
+    pthread_cond_destroy(&engine->done);
+    free(engine->workers);
+    free(engine);
+}
@@ -0,0 +1,206 @@
+/********************************************************************************************
+* Supersingular Isogeny Key Encapsulation Library
+*
+* Abstract: testing the combined library with all the parameter sets
+*********************************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "../sike_all.h"
+
+
+#define TEST_LOOPS        5
+#define ENGINE_BENCH_JOBS 64        // Encapsulations of the job engine benchmark
+
+#define PASSED    0
+#define FAILED    1
+
+
+static int kem_roundtrip(const sike_kem_t *kem_key, const sike_kem_t *kem_enc)
+{ // Key pair and decapsulation with kem_key, encapsulation with kem_enc
+    unsigned int i;
+    unsigned char sk[SIKE_MAX_SECRETKEYBYTES] = {0};
+    unsigned char pk[SIKE_MAX_PUBLICKEYBYTES] = {0};
+    unsigned char ct[SIKE_MAX_CIPHERTEXTBYTES] = {0};
+    unsigned char ss[SIKE_MAX_BYTES] = {0};
+    unsigned char ss_[SIKE_MAX_BYTES] = {0};
+
+    for (i = 0; i < TEST_LOOPS; i++) {
+        kem_key->keypair(pk, sk);
+        kem_enc->enc(ct, ss, pk);
+        kem_key->dec(ss_, ct, sk);
+        if (memcmp(ss, ss_, kem_key->shared_secret_bytes) != 0) return FAILED;
+    }
+    return PASSED;
+}
+
+
+typedef struct {
+    const sike_kem_t *kem;
+    unsigned char sk[SIKE_MAX_SECRETKEYBYTES];
+    unsigned char pk[SIKE_MAX_PUBLICKEYBYTES];
+    unsigned char ct[SIKE_MAX_CIPHERTEXTBYTES];
+    unsigned char ss[SIKE_MAX_BYTES];
+    unsigned char ss_[SIKE_MAX_BYTES];
+    sike_engine_t *engine;
+    sike_job_t job;
+    int failed;
+} engine_slot_t;
+
+
+static void engine_next(sike_job_t *job)
+{ // Callback of the keypair and enc jobs of a slot: submits the next job of the slot, the dec job without callback
+    engine_slot_t *slot = (engine_slot_t*)job->arg;
+
+    if (job->result != 0) slot->failed = 1;
+    if (job->op == SIKE_JOB_KEYPAIR) {
+        job->op = SIKE_JOB_ENC;
+        job->ss = slot->ss;
+    } else {
+        job->op = SIKE_JOB_DEC;
+        job->ss = slot->ss_;
+        job->callback = NULL;
+    }
+    if (sike_engine_submit(slot->engine, job) != 0) slot->failed = 1;
+}
+
+
+static int engine_test(unsigned int nthreads, unsigned int *nworkers)
+{ // Key pair, encapsulation and decapsulation of every variant, TEST_LOOPS times, as chains of jobs on one engine
+  // with nthreads workers. Returns the number of workers of the engine in nworkers
+    static engine_slot_t slots[TEST_LOOPS*16];
+    unsigned int i, n = TEST_LOOPS*sike_kems_count, completed = 0;
+    sike_engine_t *engine;
+    sike_job_t *job;
+    int status = PASSED;
+
+    if (n > sizeof(slots)/sizeof(slots[0])) return FAILED;
+    engine = sike_engine_create(nthreads, 1);
+    if (engine == NULL) return FAILED;
+    *nworkers = sike_engine_workers(engine);
+
+    for (i = 0; i < n; i++) {
+        engine_slot_t *slot = &slots[i];
+        memset(slot, 0, sizeof(engine_slot_t));
+        slot->kem = &sike_kems[i % sike_kems_count];
+        slot->engine = engine;
+        slot->job.kem = slot->kem;
+        slot->job.op = SIKE_JOB_KEYPAIR;
+        slot->job.pk = slot->pk;
+        slot->job.sk = slot->sk;
+        slot->job.ct = slot->ct;
+        slot->job.callback = engine_next;
+        slot->job.arg = slot;
+        if (sike_engine_submit(engine, &slot->job) != 0) status = FAILED;
+    }
+
+    // Only the dec jobs are queued for sike_engine_wait, the other jobs submit their successors
+    while ((job = sike_engine_wait(engine)) != NULL) {
+        engine_slot_t *slot = (engine_slot_t*)job->arg;
+        if (job->op != SIKE_JOB_DEC || job->result != 0 || slot->failed) status = FAILED;
+        if (memcmp(slot->ss, slot->ss_, slot->kem->shared_secret_bytes) != 0) status = FAILED;
+        completed++;
+    }
+    if (completed != n || sike_engine_poll(engine) != NULL) status = FAILED;
+
+    sike_engine_destroy(engine);
+    return status;
+}
+
+
+static double wallclock()
+{ // Wall-clock time in seconds
+    struct timespec t;
+
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (double)t.tv_sec + 1e-9*(double)t.tv_nsec;
+}
+
+
+static double engine_rate(const sike_kem_t *kem, unsigned int nthreads, unsigned int njobs, unsigned int *nworkers)
+{ // Encapsulations per second of njobs jobs on an engine with nthreads workers, whose number is returned in nworkers
+    static unsigned char pk[SIKE_MAX_PUBLICKEYBYTES], sk[SIKE_MAX_SECRETKEYBYTES];
+    static unsigned char ct[ENGINE_BENCH_JOBS][SIKE_MAX_CIPHERTEXTBYTES], ss[ENGINE_BENCH_JOBS][SIKE_MAX_BYTES];
+    static sike_job_t jobs[ENGINE_BENCH_JOBS];
+    sike_engine_t *engine = sike_engine_create(nthreads, 1);
+    unsigned int i;
+    double t;
+
+    if (engine == NULL) return 0;
+    *nworkers = sike_engine_workers(engine);
+    kem->keypair(pk, sk);
+    t = wallclock();
+    for (i = 0; i < njobs; i++) {
+        memset(&jobs[i], 0, sizeof(sike_job_t));
+        jobs[i].kem = kem;
+        jobs[i].op = SIKE_JOB_ENC;
+        jobs[i].pk = pk;
+        jobs[i].ct = ct[i];
+        jobs[i].ss = ss[i];
+        sike_engine_submit(engine, &jobs[i]);
+    }
+    while (sike_engine_wait(engine) != NULL);
+    t = wallclock() - t;
+    sike_engine_destroy(engine);
+    return njobs/t;
+}
+
+
+int main()
+{
+    unsigned int i, j;
+    const sike_kem_t *kem;
+    int status = PASSED;
+    unsigned int nworkers, nworkers2;
+    double rate, rate1;
+
+    printf("\n\nTESTING THE COMBINED LIBRARY WITH %u VARIANTS\n", sike_kems_count);
+    printf("--------------------------------------------------------------------------------------------------------\n\n");
+
+    for (i = 0; i < sike_kems_count; i++) {
+        if (kem_roundtrip(&sike_kems[i], &sike_kems[i]) == PASSED) {
+            printf("  %-16s KEM tests ..................................... PASSED\n", sike_kems[i].name);
+        } else {
+            printf("  %-16s KEM tests ... FAILED\n", sike_kems[i].name);
+            status = FAILED;
+        }
+    }
+
+    // Variants of the same parameter set in one process, each one with its own field arithmetic
+    for (i = 0; i < sike_kems_count; i++) {
+        for (j = 0; j < sike_kems_count; j++) {
+            if (i == j || strcmp(sike_kems[i].algname, sike_kems[j].algname) != 0) continue;
+            if (kem_roundtrip(&sike_kems[i], &sike_kems[j]) == PASSED) {
+                printf("  %-16s keys, %-16s encapsulation .............. PASSED\n", sike_kems[i].name, sike_kems[j].name);
+            } else {
+                printf("  %-16s keys, %-16s encapsulation ... FAILED\n", sike_kems[i].name, sike_kems[j].name);
+                status = FAILED;
+            }
+        }
+    }
+
+    kem = sike_kem_get("SIKEp751");
+    if (kem == NULL || strcmp(kem->name, "SIKEp751_mixed") != 0 || sike_kem_get("SIKEp503") != sike_kem_get("SIKEp503_mixed") ||
+        sike_kem_get("SIKEp503_gpr")->enc != sike_p503_kem_enc || sike_kem_get("SIKEp512") != NULL) {
+        printf("  Dispatch table lookup ... FAILED\n");
+        status = FAILED;
+    } else {
+        printf("  Dispatch table lookup ................................................ PASSED\n");
+    }
+
+    // Chains of jobs of all the variants, on one worker per core and on twice as many workers as cores
+    if (engine_test(0, &nworkers) == PASSED && engine_test(2*nworkers, &nworkers2) == PASSED) {
+        printf("  Job engine ........................................................... PASSED\n");
+    } else {
+        printf("  Job engine ... FAILED\n");
+        status = FAILED;
+    }
+    kem = sike_kem_get("SIKEp503");
+    rate1 = engine_rate(kem, 1, ENGINE_BENCH_JOBS, &nworkers);
+    rate = engine_rate(kem, 0, ENGINE_BENCH_JOBS, &nworkers);
+    printf("  Job engine, %s encapsulations: %8.1f ops/sec on 1 worker, %8.1f on %u workers\n", kem->name, rate1, rate, nworkers);
+    printf("\n");
+
+    return status;
+}